@@ -0,0 +1,102 @@
+// Compares marshalling numeric arrays element by element through srpc against
+// the bulk byte order conversion, for encoding and decoding.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/byte_order.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::chrono::milliseconds kMinDuration{200};
+
+// Runs fn repeatedly for at least kMinDuration, and returns the mean time per
+// run in nanoseconds.
+template <typename F>
+double Time(F &&fn) {
+  std::size_t runs = 0;
+  auto start = Clock::now();
+  auto elapsed = Clock::duration{};
+  do {
+    fn();
+    ++runs;
+    elapsed = Clock::now() - start;
+  } while (elapsed < kMinDuration);
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(runs);
+}
+
+// Keeps the compiler from discarding the results being timed.
+volatile std::byte sink;
+
+template <typename T>
+void Report(std::string_view type, std::string_view operation,
+            std::size_t count, double each_ns, double bulk_ns) {
+  auto bytes = static_cast<double>(count * sizeof(T));
+  std::printf("%-4s %-6s %8zu  each %9.3f GB/s  bulk %9.3f GB/s  %6.2fx\n",
+              type.data(), operation.data(), count, bytes / each_ns,
+              bytes / bulk_ns, each_ns / bulk_ns);
+}
+
+template <typename T>
+void Run(std::string_view type, std::size_t count) {
+  std::vector<T> values(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    values[i] = static_cast<T>(i * 2654435761U);
+  }
+  std::vector<std::byte> data(count * sizeof(T));
+
+  auto encode_each = Time([&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      auto element = srpc::Marshal<T>{}(values[i]);
+      std::copy(element.begin(), element.end(), data.data() + i * sizeof(T));
+    }
+    sink = data[count / 2];
+  });
+  auto encode_bulk = Time([&] {
+    dfis::EncodeBigEndian(std::span<const T>{values}, data.data());
+    sink = data[count / 2];
+  });
+  Report<T>(type, "encode", count, encode_each, encode_bulk);
+
+  std::vector<T> decoded(count);
+  auto decode_each = Time([&] {
+    for (std::size_t i = 0; i < count; ++i) {
+      decoded[i] = srpc::Unmarshal<T>{}(std::span<const std::byte, sizeof(T)>{
+          data.data() + i * sizeof(T), sizeof(T)});
+    }
+    sink = std::as_bytes(std::span{decoded})[count / 2];
+  });
+  auto decode_bulk = Time([&] {
+    dfis::DecodeBigEndian(data.data(), std::span<T>{decoded});
+    sink = std::as_bytes(std::span{decoded})[count / 2];
+  });
+  Report<T>(type, "decode", count, decode_each, decode_bulk);
+}
+
+}  // namespace
+
+int main() {
+  namespace internal = dfis::byte_order_internal;
+  const char *kernel = internal::HasAvx2()    ? "avx2"
+                       : internal::HasSsse3() ? "ssse3"
+                                              : "portable";
+  std::printf("kernel: %s\n", kernel);
+  for (std::size_t count : {64, 4096, 1 << 20}) {
+    Run<srpc::i32>("i32", count);
+    Run<srpc::i64>("i64", count);
+    Run<srpc::f64>("f64", count);
+  }
+  return 0;
+}
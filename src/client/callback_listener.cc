@@ -0,0 +1,93 @@
+#include "client/callback_listener.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/seat_availability.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+
+namespace dfis {
+
+std::unique_ptr<CallbackListener> CallbackListener::New(EventLoop &loop,
+                                                        srpc::u16 port,
+                                                        Handler handler,
+                                                        std::string *error) {
+  auto socket = DatagramSocket::New(port, error);
+  if (socket == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<CallbackListener> listener{
+      new CallbackListener{loop, std::move(socket), std::move(handler)}};
+  auto *watched = listener.get();
+  if (!loop.Watch(
+          watched->socket_->Fd(), [watched] { watched->Receive(); }, error)) {
+    return nullptr;
+  }
+  return listener;
+}
+
+CallbackListener::CallbackListener(EventLoop &loop,
+                                   std::unique_ptr<DatagramSocket> socket,
+                                   Handler handler)
+    : loop_(loop), socket_(std::move(socket)), handler_(std::move(handler)) {}
+
+CallbackListener::~CallbackListener() {
+  loop_.Unwatch(socket_->Fd());
+  std::lock_guard lock{mutex_};
+  for (const auto &[subscription, timer] : subscriptions_) {
+    loop_.Cancel(timer);
+  }
+}
+
+void CallbackListener::Subscribe(
+    srpc::u64 subscription, std::chrono::system_clock::time_point monitor_end,
+    std::function<void()> on_end) {
+  auto remaining = std::chrono::duration_cast<EventLoop::Clock::duration>(
+      monitor_end - std::chrono::system_clock::now());
+  std::lock_guard lock{mutex_};
+  auto it = subscriptions_.find(subscription);
+  if (it != subscriptions_.end()) {
+    // Extended by a later request for the same subscription.
+    loop_.Cancel(it->second);
+  }
+  subscriptions_[subscription] = loop_.RunAfter(
+      remaining, [this, subscription, on_end = std::move(on_end)] {
+        {
+          std::lock_guard lock{mutex_};
+          subscriptions_.erase(subscription);
+        }
+        on_end();
+      });
+}
+
+std::size_t CallbackListener::Active() const {
+  std::lock_guard lock{mutex_};
+  return subscriptions_.size();
+}
+
+void CallbackListener::Receive() {
+  for (;;) {
+    auto datagram = socket_->ReceiveFrom(std::chrono::milliseconds{0});
+    if (!datagram.has_value()) {
+      return;
+    }
+    // Anything that is not a callback is ignored.
+    auto req =
+        srpc::Unmarshal<SeatAvailabilityCallbackRequest>{}(datagram->data)
+            .second;
+    if (req.has_value()) {
+      handler_(*req);
+    }
+  }
+}
+
+}  // namespace dfis
@@ -0,0 +1,70 @@
+#ifndef DFIS_CLIENT_CALLBACK_LISTENER_H_
+#define DFIS_CLIENT_CALLBACK_LISTENER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <srpc/types/integers.h>
+
+#include "messages/seat_availability.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+
+namespace dfis {
+
+// Receives the seat availability callbacks of every subscription of a client
+// on one socket, watched by an event loop, so that any number of
+// subscriptions can be monitored while other requests are made.
+//
+// Callbacks are passed on whether or not their subscription is known, since
+// the response announcing a subscription may be handled after its first
+// callbacks arrive.
+class CallbackListener {
+ public:
+  // Called on the loop with each callback received.
+  using Handler = std::function<void(const SeatAvailabilityCallbackRequest &)>;
+
+  // Binds to the given port, or to an ephemeral one if the port is 0.
+  [[nodiscard]] static std::unique_ptr<CallbackListener> New(
+      EventLoop &loop, srpc::u16 port, Handler handler,
+      std::string *error = nullptr);
+
+  CallbackListener(const CallbackListener &) = delete;
+  CallbackListener &operator=(const CallbackListener &) = delete;
+  // Must not run while the loop is running, other than on the loop.
+  ~CallbackListener();
+
+  [[nodiscard]] srpc::u16 Port() const { return socket_->Port(); }
+
+  // Tracks a subscription until it ends, and then calls on_end on the loop.
+  // Safe to call from any thread.
+  void Subscribe(srpc::u64 subscription,
+                 std::chrono::system_clock::time_point monitor_end,
+                 std::function<void()> on_end);
+
+  // The number of subscriptions that have not ended.
+  [[nodiscard]] std::size_t Active() const;
+
+ private:
+  CallbackListener(EventLoop &loop, std::unique_ptr<DatagramSocket> socket,
+                   Handler handler);
+
+  // Handles the callbacks waiting at the socket.
+  void Receive();
+
+  EventLoop &loop_;
+  std::unique_ptr<DatagramSocket> socket_;
+  Handler handler_;
+  mutable std::mutex mutex_;
+  // The end timer of each active subscription.
+  std::unordered_map<srpc::u64, EventLoop::TimerId> subscriptions_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_CLIENT_CALLBACK_LISTENER_H_
@@ -0,0 +1,38 @@
+#include "client/callback_sequencer.h"
+
+#include <limits>
+
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+CallbackOrder CallbackSequencer::Accept(srpc::u64 subscription,
+                                        srpc::i32 identifier,
+                                        srpc::u64 sequence) {
+  auto &last = last_[{subscription, identifier}];
+  if (sequence <= last) {
+    return CallbackOrder::kStale;
+  }
+  auto order =
+      sequence == last + 1 ? CallbackOrder::kNext : CallbackOrder::kGap;
+  last = sequence;
+  return order;
+}
+
+bool CallbackSequencer::Resync(srpc::u64 subscription, srpc::i32 identifier,
+                               srpc::u64 sequence) {
+  auto &last = last_[{subscription, identifier}];
+  if (sequence <= last) {
+    return false;
+  }
+  last = sequence;
+  return true;
+}
+
+void CallbackSequencer::Forget(srpc::u64 subscription) {
+  last_.erase(
+      last_.lower_bound({subscription, std::numeric_limits<srpc::i32>::min()}),
+      last_.upper_bound({subscription, std::numeric_limits<srpc::i32>::max()}));
+}
+
+}  // namespace dfis
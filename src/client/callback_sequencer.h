@@ -0,0 +1,41 @@
+#ifndef DFIS_CLIENT_CALLBACK_SEQUENCER_H_
+#define DFIS_CLIENT_CALLBACK_SEQUENCER_H_
+
+#include <map>
+#include <utility>
+
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+enum class CallbackOrder {
+  // The update directly follows the last one seen.
+  kNext,
+  // The update is newer, but some before it were missed.
+  kGap,
+  // The update is a duplicate, or older than one already seen.
+  kStale,
+};
+
+// Tracks the last sequence number seen for each flight of each subscription.
+// Not thread-safe.
+class CallbackSequencer {
+ public:
+  // Classifies the update, and records it unless it is stale.
+  CallbackOrder Accept(srpc::u64 subscription, srpc::i32 identifier,
+                       srpc::u64 sequence);
+
+  // Records a snapshot, and returns whether it is newer than any update seen.
+  bool Resync(srpc::u64 subscription, srpc::i32 identifier,
+              srpc::u64 sequence);
+
+  // Drops what was seen of a subscription, once it has ended.
+  void Forget(srpc::u64 subscription);
+
+ private:
+  std::map<std::pair<srpc::u64, srpc::i32>, srpc::u64> last_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_CLIENT_CALLBACK_SEQUENCER_H_
@@ -0,0 +1,100 @@
+#include "client/client.h"
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+
+#include "client/pipeline.h"
+#include "messages/flight_info.h"
+#include "messages/flight_search.h"
+#include "messages/id_list.h"
+#include "messages/seat_reservation.h"
+#include "network/datagram_socket.h"
+
+namespace dfis {
+
+std::unique_ptr<Client> Client::New(const std::string &host, srpc::u16 port,
+                                    ClientOptions options,
+                                    std::string *error) {
+  auto server_addr = DatagramSocket::Resolve(host, port, error);
+  if (!server_addr.has_value()) {
+    return nullptr;
+  }
+  auto socket = DatagramSocket::New(0, error);
+  if (socket == nullptr) {
+    return nullptr;
+  }
+  return std::unique_ptr<Client>{
+      new Client{std::move(socket), *server_addr, options}};
+}
+
+Client::Client(std::unique_ptr<DatagramSocket> socket,
+               const srpc::SocketAddress &server_addr,
+               const ClientOptions &options)
+    : socket_(std::move(socket)),
+      pipeline_(std::make_unique<RequestPipeline>(
+          *socket_, server_addr, options.retry_policy, options.window)) {}
+
+std::future<std::optional<FlightSearchResponse>> Client::SearchFlights(
+    std::string source, std::string destination, srpc::u32 page_size,
+    srpc::u64 cursor) {
+  return Call<FlightSearchRequest, FlightSearchResponse>(FlightSearchRequest{
+      .id = 0,
+      .source = std::move(source),
+      .destination = std::move(destination),
+      .encoding = IdListEncoding::kDeltaVarint,
+      .page_size = page_size,
+      .cursor = cursor,
+  });
+}
+
+std::future<std::optional<PriceRangeSearchResponse>> Client::SearchPriceRange(
+    srpc::f32 from, srpc::f32 to, srpc::u32 page_size, srpc::u64 cursor) {
+  return Call<PriceRangeSearchRequest, PriceRangeSearchResponse>(
+      PriceRangeSearchRequest{
+          .id = 0,
+          .from = from,
+          .to = to,
+          .encoding = IdListEncoding::kDeltaVarint,
+          .page_size = page_size,
+          .cursor = cursor,
+      });
+}
+
+std::future<std::optional<FlightInfoResponse>> Client::GetFlightInfo(
+    srpc::i32 identifier) {
+  return Call<FlightInfoRequest, FlightInfoResponse>(FlightInfoRequest{
+      .id = 0,
+      .identifier = identifier,
+  });
+}
+
+std::future<std::optional<SeatReservationResponse>> Client::Reserve(
+    srpc::i32 identifier, srpc::i32 seats) {
+  return Call<SeatReservationRequest, SeatReservationResponse>(
+      SeatReservationRequest{
+          .id = 0,
+          .identifier = identifier,
+          .seats = seats,
+      });
+}
+
+std::future<std::optional<SeatReservationCancellationResponse>> Client::Cancel(
+    srpc::u64 reservation_id, srpc::i32 identifier, srpc::i32 seats) {
+  return Call<SeatReservationCancellationRequest,
+              SeatReservationCancellationResponse>(
+      SeatReservationCancellationRequest{
+          .id = 0,
+          .reservation_req_id = reservation_id,
+          .identifier = identifier,
+          .seats = seats,
+      });
+}
+
+}  // namespace dfis
@@ -0,0 +1,91 @@
+#ifndef DFIS_CLIENT_CLIENT_H_
+#define DFIS_CLIENT_CLIENT_H_
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+
+#include "client/pipeline.h"
+#include "messages/flight_info.h"
+#include "messages/flight_search.h"
+#include "messages/seat_reservation.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+
+namespace dfis {
+
+struct ClientOptions {
+  RetryPolicy retry_policy;
+  // The most requests in flight at a time.
+  std::size_t window = 64;
+};
+
+// A connection to a DFIS server, for programs that embed DFIS access. Every
+// call is sent at once over one long-lived socket, many may be in flight
+// together, and each returns a future of its response, or of nothing if no
+// response arrived. Safe to use from multiple threads.
+class Client {
+ public:
+  [[nodiscard]] static std::unique_ptr<Client> New(
+      const std::string &host, srpc::u16 port, ClientOptions options = {},
+      std::string *error = nullptr);
+
+  Client(const Client &) = delete;
+  Client &operator=(const Client &) = delete;
+  // Gives up on any calls in flight.
+  ~Client() = default;
+
+  // Pages through flights as described in FlightSearchRequest.
+  std::future<std::optional<FlightSearchResponse>> SearchFlights(
+      std::string source, std::string destination, srpc::u32 page_size = 0,
+      srpc::u64 cursor = 0);
+
+  std::future<std::optional<PriceRangeSearchResponse>> SearchPriceRange(
+      srpc::f32 from, srpc::f32 to, srpc::u32 page_size = 0,
+      srpc::u64 cursor = 0);
+
+  std::future<std::optional<FlightInfoResponse>> GetFlightInfo(
+      srpc::i32 identifier);
+
+  // The identifier of the response is that of the reservation, for Cancel.
+  std::future<std::optional<SeatReservationResponse>> Reserve(
+      srpc::i32 identifier, srpc::i32 seats);
+
+  std::future<std::optional<SeatReservationCancellationResponse>> Cancel(
+      srpc::u64 reservation_id, srpc::i32 identifier, srpc::i32 seats);
+
+  // Sends any other request, under a fresh identifier.
+  template <typename Req, typename Res>
+  std::future<std::optional<Res>> Call(Req req) {
+    return pipeline_->Call<Req, Res>(std::move(req));
+  }
+
+  // Sends any other request, and returns an awaitable of its response; see
+  // RequestPipeline::Await().
+  template <typename Req, typename Res>
+  auto Await(Req req, EventLoop &loop) {
+    return pipeline_->Await<Req, Res>(std::move(req), loop);
+  }
+
+  [[nodiscard]] std::size_t Outstanding() const {
+    return pipeline_->Outstanding();
+  }
+
+ private:
+  Client(std::unique_ptr<DatagramSocket> socket,
+         const srpc::SocketAddress &server_addr, const ClientOptions &options);
+
+  std::unique_ptr<DatagramSocket> socket_;
+  // Declared after the socket it receives from, so that it stops first.
+  std::unique_ptr<RequestPipeline> pipeline_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_CLIENT_CLIENT_H_
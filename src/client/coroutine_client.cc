@@ -0,0 +1,75 @@
+#include "client/coroutine_client.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+
+#include "messages/flight_info.h"
+#include "messages/flight_search.h"
+#include "messages/id_list.h"
+#include "messages/seat_reservation.h"
+#include "utils/task.h"
+
+namespace dfis {
+
+Task<std::optional<FlightSearchResponse>> CoroutineClient::SearchFlights(
+    std::string source, std::string destination, srpc::u32 page_size,
+    srpc::u64 cursor) {
+  return Call<FlightSearchRequest, FlightSearchResponse>(FlightSearchRequest{
+      .id = 0,
+      .source = std::move(source),
+      .destination = std::move(destination),
+      .encoding = IdListEncoding::kDeltaVarint,
+      .page_size = page_size,
+      .cursor = cursor,
+  });
+}
+
+Task<std::optional<PriceRangeSearchResponse>> CoroutineClient::SearchPriceRange(
+    srpc::f32 from, srpc::f32 to, srpc::u32 page_size, srpc::u64 cursor) {
+  return Call<PriceRangeSearchRequest, PriceRangeSearchResponse>(
+      PriceRangeSearchRequest{
+          .id = 0,
+          .from = from,
+          .to = to,
+          .encoding = IdListEncoding::kDeltaVarint,
+          .page_size = page_size,
+          .cursor = cursor,
+      });
+}
+
+Task<std::optional<FlightInfoResponse>> CoroutineClient::GetFlightInfo(
+    srpc::i32 identifier) {
+  return Call<FlightInfoRequest, FlightInfoResponse>(FlightInfoRequest{
+      .id = 0,
+      .identifier = identifier,
+  });
+}
+
+Task<std::optional<SeatReservationResponse>> CoroutineClient::Reserve(
+    srpc::i32 identifier, srpc::i32 seats) {
+  return Call<SeatReservationRequest, SeatReservationResponse>(
+      SeatReservationRequest{
+          .id = 0,
+          .identifier = identifier,
+          .seats = seats,
+      });
+}
+
+Task<std::optional<SeatReservationCancellationResponse>>
+CoroutineClient::Cancel(srpc::u64 reservation_id, srpc::i32 identifier,
+                        srpc::i32 seats) {
+  return Call<SeatReservationCancellationRequest,
+              SeatReservationCancellationResponse>(
+      SeatReservationCancellationRequest{
+          .id = 0,
+          .reservation_req_id = reservation_id,
+          .identifier = identifier,
+          .seats = seats,
+      });
+}
+
+}  // namespace dfis
@@ -0,0 +1,61 @@
+#ifndef DFIS_CLIENT_COROUTINE_CLIENT_H_
+#define DFIS_CLIENT_COROUTINE_CLIENT_H_
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+
+#include "client/client.h"
+#include "messages/flight_info.h"
+#include "messages/flight_search.h"
+#include "messages/seat_reservation.h"
+#include "network/event_loop.h"
+#include "utils/task.h"
+
+namespace dfis {
+
+// The calls of a Client as coroutines, for code running on an event loop:
+//
+//   auto res = co_await client.Reserve(4013, 3);
+//
+// A coroutine waiting for a response holds no thread, and is resumed on the
+// loop once the response arrives, or once the call is given up on.
+class CoroutineClient {
+ public:
+  CoroutineClient(Client &client, EventLoop &loop)
+      : client_(client), loop_(loop) {}
+
+  Task<std::optional<FlightSearchResponse>> SearchFlights(
+      std::string source, std::string destination, srpc::u32 page_size = 0,
+      srpc::u64 cursor = 0);
+
+  Task<std::optional<PriceRangeSearchResponse>> SearchPriceRange(
+      srpc::f32 from, srpc::f32 to, srpc::u32 page_size = 0,
+      srpc::u64 cursor = 0);
+
+  Task<std::optional<FlightInfoResponse>> GetFlightInfo(srpc::i32 identifier);
+
+  Task<std::optional<SeatReservationResponse>> Reserve(srpc::i32 identifier,
+                                                       srpc::i32 seats);
+
+  Task<std::optional<SeatReservationCancellationResponse>> Cancel(
+      srpc::u64 reservation_id, srpc::i32 identifier, srpc::i32 seats);
+
+  template <typename Req, typename Res>
+  Task<std::optional<Res>> Call(Req req) {
+    co_return co_await client_.Await<Req, Res>(std::move(req), loop_);
+  }
+
+  [[nodiscard]] EventLoop &Loop() { return loop_; }
+
+ private:
+  Client &client_;
+  EventLoop &loop_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_CLIENT_COROUTINE_CLIENT_H_
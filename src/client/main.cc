@@ -1,36 +1,48 @@
 #include <chrono>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <optional>
-#include <ostream>
 #include <random>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
-#include <srpc/network/datagram_client.h>
-#include <srpc/network/datagram_server.h>
-#include <srpc/network/tcp_ip.h>
 #include <srpc/types/floats.h>
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
-#include <srpc/utils/result.h>
 
+#include "client/callback_listener.h"
+#include "client/callback_sequencer.h"
+#include "client/client.h"
+#include "client/coroutine_client.h"
+#include "client/pipeline.h"
+#include "messages/batch.h"
 #include "messages/flight_info.h"
 #include "messages/flight_search.h"
-#include "messages/invocation_semantic.h"
+#include "messages/id_list.h"
+#include "messages/message_type.h"
 #include "messages/seat_availability.h"
 #include "messages/seat_reservation.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
 #include "utils/rand.h"
+#include "utils/task.h"
+#include "utils/time.h"
 
 using namespace dfis;
 
 namespace {
 
+constexpr std::chrono::milliseconds kResponseTimeout{1000};
+
 [[noreturn]] void Bye() {
   std::cout << "Bye-bye!" << std::endl;
   // NOLINTNEXTLINE(concurrency-mt-unsafe)
@@ -54,24 +66,45 @@ T PromptForInput(const std::string &prompt, const std::string &retry_prompt) {
   }
 }
 
-std::ostream &operator<<(std::ostream &ostream,
-                         const srpc::SocketAddress &addr) {
-  switch (addr.protocol) {
-    case srpc::kIPv4: return ostream << addr.address << ":" << addr.port;
-    case srpc::kIPv6:
-      return ostream << "[" << addr.address << "]:" << addr.port;
+srpc::u32 PromptForPageSize() {
+  return PromptForInput<srpc::u32>(
+      "Enter the most flights to list at a time (0 for all): ",
+      "Please enter a non-negative integer: ");
+}
+
+std::vector<srpc::i32> PromptForIdentifiers() {
+  std::cout << "Enter identifiers, separated by spaces: " << std::flush;
+  for (;;) {
+    std::string line;
+    if (!std::getline(std::cin, line)) {
+      Bye();
+    }
+    std::istringstream ss{line};
+    std::vector<srpc::i32> identifiers;
+    srpc::i32 identifier;
+    while (ss >> identifier) {
+      identifiers.push_back(identifier);
+    }
+    if (!identifiers.empty() && ss.eof()) {
+      return identifiers;
+    }
+    std::cout << "Please enter integers: " << std::flush;
   }
-  assert(false);
 }
 
-void RandomDelay(srpc::i64 from_ms = 0, srpc::i64 to_ms = 200) {
-  static std::random_device rand;
-  auto sleep_ms = std::chrono::milliseconds(
-      std::uniform_int_distribution<std::chrono::milliseconds::rep>{
-          from_ms, to_ms}(rand));
-  std::clog << "Info: Simulating delay for " << sleep_ms.count() << "ms"
-            << std::endl;
-  std::this_thread::sleep_for(sleep_ms);
+// Asks whether to fetch the page at the cursor, if there is one.
+bool PromptForNextPage(srpc::u64 next_cursor) {
+  if (next_cursor == 0) {
+    return false;
+  }
+  for (;;) {
+    auto answer = PromptForInput<std::string>("List more flights? (y/n): ",
+                                              "Please enter y or n: ");
+    if (answer == "y" || answer == "n") {
+      return answer == "y";
+    }
+    std::cout << "Please enter y or n." << std::endl;
+  }
 }
 
 bool RandomLoss(srpc::f32 loss_prob = 0.1) {
@@ -80,109 +113,216 @@ bool RandomLoss(srpc::f32 loss_prob = 0.1) {
 }
 
 template <typename Req, typename Res>
-std::optional<Res> SendAndReceive(std::unique_ptr<srpc::DatagramClient> &client,
-                                  const std::string &server_addr,
-                                  srpc::u16 server_port, Req req) {
-  req.id = MakeMessageIdentifier();
-
-  std::vector<std::byte> resp_bytes;
-  constexpr int retry_times = 3;
-  int attempt = 0;
-  while (attempt <= retry_times) {
-    auto resp_bytes_res = client->SendAndReceive(srpc::Marshal<Req>{}(req));
-    if (!resp_bytes_res.OK()) {
-      std::clog << "Info: Unable to receive response: "
-                << resp_bytes_res.Error() << std::endl;
-      if (++attempt <= retry_times) {
-        std::clog << "Info: Retrying; attempt " << attempt << std::endl;
-      }
-      continue;
-    }
-    resp_bytes = std::move(resp_bytes_res.Value());
-    break;
-  }
-  if (attempt > retry_times) {
-    std::cerr << "Error: Unable to receive response after " << retry_times
-              << " retries" << std::endl;
+std::optional<Res> SendAndReceive(Client &client, Req req) {
+  auto res = client.Call<Req, Res>(std::move(req)).get();
+  if (!res.has_value()) {
+    std::cerr << "Error: Unable to receive response" << std::endl;
     return {};
   }
+  std::cout << "Received response:\n" << *res << std::endl;
+  return res;
+}
 
-  auto resp_res = srpc::Unmarshal<Res>{}(resp_bytes);
-  if (!resp_res.second.has_value()) {
-    std::cerr << "Error: Failed to unmarshal response" << std::endl;
+// Parses a request to batch, given as "info <identifier>" or
+// "reserve <identifier> <seats>", and marshals it.
+std::optional<std::vector<std::byte>> ParseBatchItem(const std::string &line) {
+  std::istringstream ss{line};
+  std::string kind;
+  srpc::i32 identifier;
+  if (!(ss >> kind >> identifier)) {
     return {};
   }
+  if (kind == "info" && (ss >> std::ws).eof()) {
+    return srpc::Marshal<FlightInfoRequest>{}(FlightInfoRequest{
+        .id = MakeMessageIdentifier(),
+        .identifier = identifier,
+    });
+  }
+  srpc::i32 seats;
+  if (kind == "reserve" && ss >> seats && (ss >> std::ws).eof()) {
+    return srpc::Marshal<SeatReservationRequest>{}(SeatReservationRequest{
+        .id = MakeMessageIdentifier(),
+        .identifier = identifier,
+        .seats = seats,
+    });
+  }
+  return {};
+}
 
-  auto resp = std::move(*resp_res.second);
-  std::cout << "Received response:\n" << resp << std::endl;
-  return resp;
+template <typename Res>
+void PrintBatchItem(std::span<const std::byte> res_data) {
+  auto res_res = srpc::Unmarshal<Res>{}(res_data);
+  if (!res_res.second.has_value()) {
+    std::cout << "(malformed response)" << std::endl;
+    return;
+  }
+  std::cout << *res_res.second << std::endl;
 }
 
-std::optional<std::vector<std::byte>> ServeSeatAvailabilityCallbacks(
-    InvocationSemantic semantic, const srpc::SocketAddress &from_addr,
-    srpc::Result<std::vector<std::byte>> req_data_res) {
-  if (!req_data_res.OK()) {
-    std::cerr << "Error: Could not receive seat availability callback from "
-              << from_addr << ": " << req_data_res.Error() << std::endl;
-    return {};
+void PrintBatchItem(std::span<const std::byte> res_data) {
+  auto header = Decode<MessageHeader>(res_data).second;
+  if (!header.has_value()) {
+    std::cout << "(no response)" << std::endl;
+    return;
+  }
+  switch (MessageType{header->type}) {
+    case MessageType::kFlightInfoResponse:
+      PrintBatchItem<FlightInfoResponse>(res_data);
+      return;
+    case MessageType::kSeatReservationResponse:
+      PrintBatchItem<SeatReservationResponse>(res_data);
+      return;
+    default: std::cout << "(unknown response)" << std::endl; return;
   }
+}
 
-  auto req_data = std::move(req_data_res.Value());
-  auto req_res = srpc::Unmarshal<SeatAvailabilityCallbackRequest>{}(req_data);
-  if (!req_res.second.has_value()) {
-    std::cerr << "Error: Could not unmarshal seat availability callback"
+// Runs on the event loop, where waiting for a snapshot to resynchronise does
+// not hold up the callbacks that follow.
+Task<> HandleSeatAvailabilityCallback(
+    CoroutineClient &client, std::shared_ptr<CallbackSequencer> sequencer,
+    SeatAvailabilityCallbackRequest req) {
+  auto order =
+      sequencer->Accept(req.subscription, req.identifier, req.sequence);
+  if (order == CallbackOrder::kStale) {
+    std::clog << "Info: Ignoring stale seat availability callback " << req
               << std::endl;
-    return {};
+    co_return;
+  }
+  std::cout << "Received seat availability callback: " << req << std::endl;
+  if (order != CallbackOrder::kGap) {
+    co_return;
   }
 
-  static std::unordered_map<srpc::u64,
-                            std::pair<SeatAvailabilityCallbackRequest,
-                                      SeatAvailabilityCallbackResponse>>
-      history;
+  std::clog << "Info: Missed update(s) of flight " << req.identifier
+            << "; resynchronising" << std::endl;
+  auto res = co_await client.Call<SeatAvailabilitySnapshotRequest,
+                                  SeatAvailabilitySnapshotResponse>(
+      SeatAvailabilitySnapshotRequest{
+          .id = 0,
+          .subscription = req.subscription,
+          .identifier = req.identifier,
+      });
+  if (!res.has_value()) {
+    std::cerr << "Error: Unable to receive seat availability snapshot"
+              << std::endl;
+    co_return;
+  }
+  if (res->status_code == 0 &&
+      sequencer->Resync(req.subscription, req.identifier, res->sequence)) {
+    std::cout << "Resynchronised seat availability: " << *res << std::endl;
+  }
+}
 
-  auto req = *req_res.second;
-  std::cout << "Received seat availability callback: " << req << std::endl;
+// Runs on the event loop, like HandleSeatAvailabilityCallback().
+Task<> HandleMulticastSeatAvailability(
+    CoroutineClient &client, std::shared_ptr<CallbackSequencer> sequencer,
+    SeatAvailabilityCallbackRequest req) {
+  auto order =
+      sequencer->Accept(req.subscription, req.identifier, req.sequence);
+  if (order == CallbackOrder::kStale) {
+    co_return;
+  }
+  std::cout << "Received seat availability update: " << req << std::endl;
+  if (order != CallbackOrder::kGap) {
+    co_return;
+  }
 
-  auto req_lost = RandomLoss(0.1);
-  auto res_lost = RandomLoss(0.2);
-  if (req_lost) {
-    std::clog << "Info: Callback request " << req.id
-              << " is simulated to be lost" << std::endl;
-    return {};
+  std::clog << "Info: Missed update(s) of flight " << req.identifier
+            << "; fetching flight info" << std::endl;
+  auto res = co_await client.GetFlightInfo(req.identifier);
+  if (!res.has_value()) {
+    std::cerr << "Error: Unable to receive flight info" << std::endl;
+    co_return;
   }
-  RandomDelay();
+  std::cout << "Received response: " << *res << std::endl;
+}
 
-  if (semantic == InvocationSemantic::kAtMostOnce && history.contains(req.id)) {
-    std::clog << "Info: " << req.id << " is a duplicate request" << std::endl;
-    auto res = history[req.id].second;
-    if (res_lost) {
-      std::clog << "Info: Callback response " << res.id
+// Handles the multicast updates of the given flight waiting at the socket.
+void ServeMulticastSeatAvailability(
+    CoroutineClient &client, DatagramSocket &receiver, srpc::i32 identifier,
+    const std::shared_ptr<CallbackSequencer> &sequencer) {
+  for (;;) {
+    std::string error;
+    auto datagram = receiver.ReceiveFrom(std::chrono::milliseconds{0}, &error);
+    if (!datagram.has_value()) {
+      if (!error.empty()) {
+        std::cerr << "Error: " << error << std::endl;
+      }
+      return;
+    }
+    auto req_res =
+        srpc::Unmarshal<SeatAvailabilityCallbackRequest>{}(datagram->data);
+    // The group may be shared with other flights.
+    if (!req_res.second.has_value() ||
+        req_res.second->identifier != identifier) {
+      continue;
+    }
+    auto req = *req_res.second;
+    if (RandomLoss(0.1)) {
+      std::clog << "Info: Multicast update " << req.id
                 << " is simulated to be lost" << std::endl;
-      return {};
+      continue;
     }
-    RandomDelay();
-    std::clog << "Info: Returning saved response " << res << std::endl;
-    return srpc::Marshal<SeatAvailabilityCallbackResponse>{}(res);
+    Spawn(HandleMulticastSeatAvailability(client, sequencer, req));
   }
+}
 
-  SeatAvailabilityCallbackResponse res{
-      .id = req.id,
-      .status_code = 0,
-  };
-  if (semantic == InvocationSemantic::kAtMostOnce) {
-    history[req.id] = {req, res};
+// Calls on_readable on the event loop whenever the socket has data, until
+// monitor_end, and then closes the socket.
+bool WatchUntil(EventLoop &loop, std::shared_ptr<DatagramSocket> socket,
+                srpc::i64 monitor_end, std::function<void()> on_readable) {
+  std::string error;
+  if (!loop.Watch(socket->Fd(), std::move(on_readable), &error)) {
+    std::cerr << "Error: " << error << std::endl;
+    return false;
   }
+  auto remaining = std::chrono::system_clock::from_time_t(monitor_end) -
+                   std::chrono::system_clock::now();
+  loop.RunAfter(
+      std::chrono::duration_cast<EventLoop::Clock::duration>(remaining),
+      [&loop, socket = std::move(socket)] { loop.Unwatch(socket->Fd()); });
+  return true;
+}
 
-  if (res_lost) {
-    std::clog << "Info: Callback response " << res.id
-              << " is simulated to be lost" << std::endl;
-    return {};
-  }
-  RandomDelay();
+// Tracks a subscription on the shared callback socket, without waiting for
+// it to end.
+void Monitor(CallbackListener &listener,
+             std::shared_ptr<CallbackSequencer> sequencer,
+             srpc::u64 subscription, srpc::i64 monitor_end) {
+  listener.Subscribe(
+      subscription, std::chrono::system_clock::from_time_t(monitor_end),
+      [sequencer = std::move(sequencer), subscription] {
+        sequencer->Forget(subscription);
+        std::clog << "Info: Subscription " << subscription << " has ended"
+                  << std::endl;
+      });
+  std::clog << "Info: Monitoring subscription " << subscription << " until "
+            << FormatTimestamp(monitor_end) << "; " << listener.Active()
+            << " subscription(s) active" << std::endl;
+}
 
-  std::clog << "Info: Sending callback response to " << from_addr << ": " << res
+void ListenForMulticastSeatAvailability(
+    CoroutineClient &client, const MulticastMonitoringResponse &res) {
+  std::string error;
+  std::shared_ptr<DatagramSocket> receiver =
+      DatagramSocket::NewMulticastReceiver(res.group, res.port, "0.0.0.0",
+                                           &error);
+  if (receiver == nullptr) {
+    std::cerr << "Failed to join multicast group: " << error << std::endl;
+    return;
+  }
+  auto sequencer = std::make_shared<CallbackSequencer>();
+  if (!WatchUntil(client.Loop(), receiver, res.monitor_end,
+                  [&client, &receiver = *receiver, identifier = res.identifier,
+                   sequencer] {
+                    ServeMulticastSeatAvailability(client, receiver,
+                                                   identifier, sequencer);
+                  })) {
+    return;
+  }
+  std::clog << "Info: Monitoring flight " << res.identifier
+            << " via multicast until " << FormatTimestamp(res.monitor_end)
             << std::endl;
-  return srpc::Marshal<SeatAvailabilityCallbackResponse>{}(res);
 }
 
 }  // namespace
@@ -196,14 +336,13 @@ int main(int argc, char **argv) {
     std::exit(EXIT_FAILURE);
   }
 
-  InvocationSemantic semantic;
   std::string server_addr = argv[2];
   auto server_port = static_cast<srpc::u16>(std::atoi(argv[3]));
+  // Only requests carry an invocation semantic, and the server applies it.
+  // Callbacks are one-way, and deduplicated by sequence number.
   if (std::strcmp(argv[1], "at-least-once") == 0) {
-    semantic = InvocationSemantic::kAtLeastOnce;
     std::clog << "Info: At-least-once semantic is used" << std::endl;
   } else if (std::strcmp(argv[1], "at-most-once") == 0) {
-    semantic = InvocationSemantic::kAtMostOnce;
     std::clog << "Info: At-most-once semantic is used" << std::endl;
   } else {
     std::cerr << "Error: Invalid invocation semantic: " << argv[1] << std::endl;
@@ -211,14 +350,53 @@ int main(int argc, char **argv) {
     std::exit(EXIT_FAILURE);
   }
 
-  auto client_res = srpc::DatagramClient::New(server_addr, server_port);
-  if (!client_res.OK()) {
-    std::cerr << "Error: Unable to create client: " << client_res.Error()
+  std::string error;
+  auto client = Client::New(server_addr, server_port,
+                            ClientOptions{
+                                .retry_policy =
+                                    RetryPolicy{
+                                        .initial_timeout = kResponseTimeout,
+                                        .retry_times = 3,
+                                    },
+                            },
+                            &error);
+  if (client == nullptr) {
+    std::cerr << "Error: Unable to create client: " << error << std::endl;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    std::exit(EXIT_FAILURE);
+  }
+  // Callbacks are handled on the event loop.
+  auto loop = EventLoop::New(&error);
+  if (loop == nullptr) {
+    std::cerr << "Error: Unable to create event loop: " << error << std::endl;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    std::exit(EXIT_FAILURE);
+  }
+  CoroutineClient coroutine_client{*client, *loop};
+  // Every subscription shares one callback socket.
+  auto sequencer = std::make_shared<CallbackSequencer>();
+  auto listener = CallbackListener::New(
+      *loop, 0,
+      [&coroutine_client,
+       sequencer](const SeatAvailabilityCallbackRequest &req) {
+        if (RandomLoss(0.1)) {
+          std::clog << "Info: Callback request " << req.id
+                    << " is simulated to be lost" << std::endl;
+          return;
+        }
+        // Callbacks are one-way; nothing is sent back.
+        Spawn(HandleSeatAvailabilityCallback(coroutine_client, sequencer, req));
+      },
+      &error);
+  if (listener == nullptr) {
+    std::cerr << "Error: Unable to create callback listener: " << error
               << std::endl;
     // NOLINTNEXTLINE(concurrency-mt-unsafe)
     std::exit(EXIT_FAILURE);
   }
-  auto client = std::move(client_res.Value());
+  std::clog << "Info: Listening for callbacks at port " << listener->Port()
+            << std::endl;
+  std::thread{[&loop] { loop->Run(); }}.detach();
 
   bool first_launch = true;
   for (;;) {
@@ -235,6 +413,10 @@ int main(int argc, char **argv) {
 4. Seat availability monitoring
 5. Price range search
 6. Seat reservation cancellation
+7. Route seat availability monitoring
+8. Seat availability monitoring via multicast
+9. Batch of flight info and seat reservations
+10. Pipelined flight info lookups
 Enter selection: )SEL"
               << std::flush;
     std::string line;
@@ -247,16 +429,24 @@ Enter selection: )SEL"
                                                "Please enter a string: ");
       req.destination = PromptForInput<std::string>("Enter destination: ",
                                                     "Please enter a string: ");
-      SendAndReceive<FlightSearchRequest, FlightSearchResponse>(
-          client, server_addr, server_port, req);
+      req.encoding = IdListEncoding::kDeltaVarint;
+      req.page_size = PromptForPageSize();
+      req.cursor = 0;
+      for (;;) {
+        auto res = SendAndReceive<FlightSearchRequest, FlightSearchResponse>(
+            *client, req);
+        if (!res.has_value() || !PromptForNextPage(res->next_cursor)) {
+          break;
+        }
+        req.cursor = res->next_cursor;
+      }
       continue;
     }
     if (line == "2") {
       FlightInfoRequest req;
       req.identifier = PromptForInput<srpc::i32>("Enter identifier: ",
                                                  "Please enter an integer: ");
-      SendAndReceive<FlightInfoRequest, FlightInfoResponse>(client, server_addr,
-                                                            server_port, req);
+      SendAndReceive<FlightInfoRequest, FlightInfoResponse>(*client, req);
       continue;
     }
     if (line == "3") {
@@ -266,41 +456,36 @@ Enter selection: )SEL"
       req.seats = PromptForInput<srpc::i32>(
           "Enter number of seats to reserve: ", "Please enter an integer: ");
       SendAndReceive<SeatReservationRequest, SeatReservationResponse>(
-          client, server_addr, server_port, req);
+          *client, req);
       continue;
     }
     if (line == "4") {
       SeatAvailabilityMonitoringRequest req;
       req.identifier = PromptForInput<srpc::i32>("Enter identifier: ",
                                                  "Please enter an integer: ");
-      req.port = PromptForInput<srpc::u16>("Enter port number: ",
-                                           "Please enter an integer: ");
+      req.port = listener->Port();
       req.monitor_interval_sec = PromptForInput<srpc::i32>(
           "Enter monitor interval in seconds: ", "Please enter an integer: ");
+      req.coalesce_window_ms = PromptForInput<srpc::i32>(
+          "Enter coalescing window in milliseconds (0 to disable): ",
+          "Please enter an integer: ");
+      req.trigger = SeatAvailabilityTrigger{
+          static_cast<srpc::i8>(PromptForInput<int>(
+              "Enter trigger (0. Every change, 1. Falls below, 2. Rises to, "
+              "3. Crosses): ",
+              "Please enter an integer: "))};
+      req.threshold = 0;
+      if (req.trigger != SeatAvailabilityTrigger::kEveryChange) {
+        req.threshold = PromptForInput<srpc::i32>("Enter threshold: ",
+                                                  "Please enter an integer: ");
+      }
       auto res = SendAndReceive<SeatAvailabilityMonitoringRequest,
                                 SeatAvailabilityMonitoringResponse>(
-          client, server_addr, server_port, req);
-      if (!res.has_value()) {
-        continue;
-      }
-      auto server_res = srpc::DatagramServer::New(req.port);
-      if (!server_res.OK()) {
-        std::cerr << "Failed to create server for callback listening: "
-                  << server_res.Error() << std::endl;
+          *client, req);
+      if (!res.has_value() || res->status_code != 0) {
         continue;
       }
-      auto server = std::move(server_res.Value());
-      std::thread{[semantic](auto server) {
-                    server->Listen(
-                        [semantic](const auto &from_addr, auto req_data_res) {
-                          return ServeSeatAvailabilityCallbacks(
-                              semantic, from_addr, req_data_res);
-                        });
-                  },
-                  std::move(server)}
-          .detach();
-      std::this_thread::sleep_until(
-          std::chrono::system_clock::from_time_t(res->monitor_end));
+      Monitor(*listener, sequencer, res->subscription, res->monitor_end);
       continue;
     }
     if (line == "5") {
@@ -309,8 +494,18 @@ Enter selection: )SEL"
                                            "Please enter a number: ");
       req.to = PromptForInput<srpc::f32>("Enter upper bound of price range: ",
                                          "Please enter a number: ");
-      SendAndReceive<PriceRangeSearchRequest, PriceRangeSearchResponse>(
-          client, server_addr, server_port, req);
+      req.encoding = IdListEncoding::kDeltaVarint;
+      req.page_size = PromptForPageSize();
+      req.cursor = 0;
+      for (;;) {
+        auto res =
+            SendAndReceive<PriceRangeSearchRequest, PriceRangeSearchResponse>(
+                *client, req);
+        if (!res.has_value() || !PromptForNextPage(res->next_cursor)) {
+          break;
+        }
+        req.cursor = res->next_cursor;
+      }
       continue;
     }
     if (line == "6") {
@@ -323,8 +518,114 @@ Enter selection: )SEL"
       req.seats = PromptForInput<srpc::i32>("Enter number of seats to cancel: ",
                                             "Please enter an integer: ");
       SendAndReceive<SeatReservationCancellationRequest,
-                     SeatReservationCancellationResponse>(client, server_addr,
-                                                          server_port, req);
+                     SeatReservationCancellationResponse>(*client, req);
+      continue;
+    }
+    if (line == "7") {
+      RouteMonitoringRequest req;
+      req.source = PromptForInput<std::string>("Enter source: ",
+                                               "Please enter a string: ");
+      req.destination = PromptForInput<std::string>("Enter destination: ",
+                                                    "Please enter a string: ");
+      req.departure_from = PromptForInput<srpc::i64>(
+          "Enter earliest departure as a Unix timestamp (0 for any): ",
+          "Please enter an integer: ");
+      req.departure_to = PromptForInput<srpc::i64>(
+          "Enter latest departure as a Unix timestamp (0 for any): ",
+          "Please enter an integer: ");
+      req.port = listener->Port();
+      req.monitor_interval_sec = PromptForInput<srpc::i32>(
+          "Enter monitor interval in seconds: ", "Please enter an integer: ");
+      req.coalesce_window_ms = PromptForInput<srpc::i32>(
+          "Enter coalescing window in milliseconds (0 to disable): ",
+          "Please enter an integer: ");
+      req.trigger = SeatAvailabilityTrigger{
+          static_cast<srpc::i8>(PromptForInput<int>(
+              "Enter trigger (0. Every change, 1. Falls below, 2. Rises to, "
+              "3. Crosses): ",
+              "Please enter an integer: "))};
+      req.threshold = 0;
+      if (req.trigger != SeatAvailabilityTrigger::kEveryChange) {
+        req.threshold = PromptForInput<srpc::i32>("Enter threshold: ",
+                                                  "Please enter an integer: ");
+      }
+      auto res =
+          SendAndReceive<RouteMonitoringRequest, RouteMonitoringResponse>(
+              *client, req);
+      if (!res.has_value() || res->status_code != 0) {
+        continue;
+      }
+      Monitor(*listener, sequencer, res->subscription, res->monitor_end);
+      continue;
+    }
+    if (line == "8") {
+      MulticastMonitoringRequest req;
+      req.identifier = PromptForInput<srpc::i32>("Enter identifier: ",
+                                                 "Please enter an integer: ");
+      req.monitor_interval_sec = PromptForInput<srpc::i32>(
+          "Enter monitor interval in seconds: ", "Please enter an integer: ");
+      auto res = SendAndReceive<MulticastMonitoringRequest,
+                                MulticastMonitoringResponse>(
+          *client, req);
+      if (!res.has_value() || res->status_code != 0) {
+        continue;
+      }
+      ListenForMulticastSeatAvailability(coroutine_client, *res);
+      continue;
+    }
+    if (line == "9") {
+      BatchRequest req;
+      std::cout << "Enter one request per line, as \"info <identifier>\" or "
+                   "\"reserve <identifier> <seats>\", and an empty line to "
+                   "send:"
+                << std::endl;
+      for (;;) {
+        std::string item;
+        if (!std::getline(std::cin, item)) {
+          Bye();
+        }
+        if (item.empty()) {
+          break;
+        }
+        auto item_data = ParseBatchItem(item);
+        if (!item_data.has_value()) {
+          std::cout << "Please enter a valid request." << std::endl;
+          continue;
+        }
+        req.requests.push_back(std::move(*item_data));
+      }
+      auto res = SendAndReceive<BatchRequest, BatchResponse>(*client, req);
+      if (!res.has_value() || res->status_code != 0) {
+        continue;
+      }
+      for (const auto &item_res_data : res->responses) {
+        PrintBatchItem(item_res_data);
+      }
+      continue;
+    }
+    if (line == "10") {
+      auto identifiers = PromptForIdentifiers();
+      auto start = std::chrono::steady_clock::now();
+      // Every request is sent before any response is waited for.
+      std::vector<std::future<std::optional<FlightInfoResponse>>> futures;
+      futures.reserve(identifiers.size());
+      for (auto identifier : identifiers) {
+        futures.push_back(client->GetFlightInfo(identifier));
+      }
+      std::size_t received = 0;
+      for (auto &future : futures) {
+        auto res = future.get();
+        if (!res.has_value()) {
+          std::cout << "(no response)" << std::endl;
+          continue;
+        }
+        ++received;
+        std::cout << *res << std::endl;
+      }
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+      std::clog << "Info: Received " << received << " of " << futures.size()
+                << " response(s) in " << elapsed.count() << " ms" << std::endl;
       continue;
     }
 
@@ -0,0 +1,246 @@
+#include "client/pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/fragment.h"
+#include "messages/message_type.h"
+#include "messages/timed_request.h"
+#include "network/datagram_socket.h"
+#include "network/fragmentation.h"
+#include "network/retransmission.h"
+
+namespace dfis {
+
+namespace {
+
+// The longest the background thread waits before checking whether it is
+// stopping, or whether a newly sent request is due for retransmission.
+constexpr std::chrono::milliseconds kPollInterval{10};
+
+srpc::u32 TimeBudgetMs(RequestPipeline::Clock::duration remaining) {
+  auto ms = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+  return static_cast<srpc::u32>(std::clamp<decltype(ms)>(
+      ms, 0, std::numeric_limits<srpc::u32>::max()));
+}
+
+}  // namespace
+
+RequestPipeline::RequestPipeline(DatagramSocket &socket,
+                                 srpc::SocketAddress server_addr,
+                                 RetryPolicy policy, std::size_t window)
+    : socket_(socket),
+      server_addr_(std::move(server_addr)),
+      policy_(policy),
+      window_(std::max<std::size_t>(window, 1)),
+      rtt_(policy.initial_timeout, policy.min_timeout, policy.max_timeout),
+      retry_budget_(policy.retry_budget_tokens, policy.retry_budget_ratio),
+      rand_(std::random_device{}()),
+      receiver_([this] { Run(); }) {}
+
+RequestPipeline::~RequestPipeline() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  window_cv_.notify_all();
+  receiver_.join();
+  for (auto &[id, pending] : pending_) {
+    pending.callback({});
+  }
+}
+
+void RequestPipeline::Send(srpc::u64 id, std::vector<std::byte> req_data,
+                           Callback callback) {
+  std::unique_lock lock{mutex_};
+  window_cv_.wait(lock,
+                  [this] { return stopping_ || pending_.size() < window_; });
+  if (stopping_) {
+    lock.unlock();
+    callback({});
+    return;
+  }
+  if (pending_.contains(id)) {
+    // The identifier is already in flight, so the responses could not be told
+    // apart.
+    lock.unlock();
+    callback({});
+    return;
+  }
+  auto now = Clock::now();
+  // Waits as long as every transmission would if none were answered.
+  auto give_up_at = now;
+  for (int attempt = 0; attempt <= policy_.retry_times; ++attempt) {
+    give_up_at += rtt_.Timeout(attempt);
+  }
+  auto timeout = rtt_.Timeout();
+  auto retransmit_at = std::min(now + Jitter(timeout), give_up_at);
+  auto it = pending_
+                .emplace(id, Pending{
+                                 .req_data = std::move(req_data),
+                                 .callback = std::move(callback),
+                                 .reassembler = FragmentReassembler{id},
+                                 .attempts = 0,
+                                 .timeout = timeout,
+                                 .sent_at = now,
+                                 .retransmit_at = retransmit_at,
+                                 .give_up_at = give_up_at,
+                             })
+                .first;
+  timers_.emplace(retransmit_at, id);
+  Transmit(id, it->second, now);
+}
+
+std::size_t RequestPipeline::Outstanding() const {
+  std::lock_guard lock{mutex_};
+  return pending_.size();
+}
+
+void RequestPipeline::Run() {
+  std::vector<Completion> completions;
+  std::unique_lock lock{mutex_};
+  while (!stopping_) {
+    auto timeout = kPollInterval;
+    if (!timers_.empty()) {
+      timeout = std::clamp(
+          std::chrono::ceil<std::chrono::milliseconds>(
+              timers_.begin()->first - Clock::now()),
+          std::chrono::milliseconds{0}, kPollInterval);
+    }
+    lock.unlock();
+    auto datagram = socket_.ReceiveFrom(timeout);
+    lock.lock();
+
+    if (datagram.has_value()) {
+      Accept(std::move(datagram->data), completions);
+    }
+    Expire(Clock::now(), completions);
+    if (completions.empty()) {
+      continue;
+    }
+    window_cv_.notify_all();
+    lock.unlock();
+    for (auto &[callback, res_data] : completions) {
+      callback(std::move(res_data));
+    }
+    completions.clear();
+    lock.lock();
+  }
+}
+
+void RequestPipeline::Accept(std::vector<std::byte> data,
+                             std::vector<Completion> &completions) {
+  auto fragment = srpc::Unmarshal<Fragment>{}(data).second;
+  srpc::u64 id;
+  if (fragment.has_value()) {
+    id = fragment->request_id;
+  } else {
+    auto header = Decode<MessageHeader>(data).second;
+    if (!header.has_value()) {
+      return;
+    }
+    id = header->id;
+  }
+  // Late and duplicate responses are no longer pending.
+  auto it = pending_.find(id);
+  if (it == pending_.end()) {
+    return;
+  }
+  auto &pending = it->second;
+  auto res_data = fragment.has_value() ? pending.reassembler.Add(*fragment)
+                                       : std::move(data);
+  if (!res_data.has_value()) {
+    return;
+  }
+  // The response to a retransmitted request may answer any of its copies.
+  if (pending.attempts == 0) {
+    rtt_.Sample(std::chrono::duration_cast<RttEstimator::Duration>(
+        Clock::now() - pending.sent_at));
+  }
+  retry_budget_.OnSuccess();
+  Complete(id, std::move(res_data), completions);
+}
+
+void RequestPipeline::Expire(Clock::time_point now,
+                             std::vector<Completion> &completions) {
+  while (!timers_.empty() && timers_.begin()->first <= now) {
+    auto id = timers_.begin()->second;
+    timers_.erase(timers_.begin());
+    auto &pending = pending_.at(id);
+    if (now >= pending.give_up_at) {
+      Complete(id, {}, completions);
+      continue;
+    }
+    if (pending.attempts >= policy_.retry_times ||
+        !retry_budget_.TryRetry()) {
+      // The copies already sent may still be answered.
+      pending.retransmit_at = pending.give_up_at;
+      timers_.emplace(pending.retransmit_at, id);
+      continue;
+    }
+    // Only a timeout that leads to a retransmission backs off, so that the
+    // final wait of a request does not lengthen the timeouts of others.
+    rtt_.OnTimeout(pending.timeout);
+    ++pending.attempts;
+    pending.timeout = rtt_.Timeout();
+    pending.retransmit_at =
+        std::min(now + Jitter(pending.timeout), pending.give_up_at);
+    timers_.emplace(pending.retransmit_at, id);
+    Transmit(id, pending, now);
+  }
+}
+
+void RequestPipeline::Complete(srpc::u64 id,
+                               std::optional<std::vector<std::byte>> res_data,
+                               std::vector<Completion> &completions) {
+  auto node = pending_.extract(id);
+  timers_.erase({node.mapped().retransmit_at, id});
+  completions.emplace_back(std::move(node.mapped().callback),
+                           std::move(res_data));
+}
+
+RequestPipeline::Clock::duration RequestPipeline::Jitter(
+    RttEstimator::Duration timeout) {
+  auto jitter = std::uniform_real_distribution<srpc::f64>{
+      1 - policy_.jitter, 1 + policy_.jitter}(rand_);
+  return std::chrono::duration_cast<Clock::duration>(timeout * jitter);
+}
+
+void RequestPipeline::Transmit(srpc::u64 id, const Pending &pending,
+                               Clock::time_point now) {
+  // A failed send is retried like a lost one.
+  std::string error;
+  if (!pending.reassembler.Started()) {
+    socket_.SendTo(server_addr_,
+                   srpc::Marshal<TimedRequest>{}(TimedRequest{
+                       .id = id,
+                       .time_budget_ms = TimeBudgetMs(pending.give_up_at - now),
+                       .request = pending.req_data,
+                   }),
+                   &error);
+    return;
+  }
+  socket_.SendTo(server_addr_,
+                 srpc::Marshal<FragmentRetransmitRequest>{}(
+                     FragmentRetransmitRequest{
+                         .message_id = pending.reassembler.MessageId(),
+                         .missing = pending.reassembler.Missing(),
+                     }),
+                 &error);
+}
+
+}  // namespace dfis
@@ -0,0 +1,188 @@
+#ifndef DFIS_CLIENT_PIPELINE_H_
+#define DFIS_CLIENT_PIPELINE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+#include "network/fragmentation.h"
+#include "network/retransmission.h"
+#include "utils/rand.h"
+
+namespace dfis {
+
+struct RetryPolicy {
+  // How long to wait for a response before sending the request again, until
+  // a round-trip time has been measured. Timeouts then follow the measured
+  // round-trip time, and double with each retransmission of a request.
+  std::chrono::milliseconds initial_timeout{1000};
+  std::chrono::milliseconds min_timeout{50};
+  std::chrono::milliseconds max_timeout{8000};
+  // How many times to send a request again before giving up on it.
+  int retry_times = 3;
+  // Timeouts vary randomly by up to this fraction either way, so that
+  // requests lost together are not sent again together.
+  srpc::f64 jitter = 0.1;
+  // Bounds retransmissions to a fraction of the responses; see RetryBudget.
+  srpc::f64 retry_budget_tokens = 10;
+  srpc::f64 retry_budget_ratio = 0.1;
+};
+
+// Keeps many requests to one server in flight at once on a single socket.
+// Responses, whole or in fragments, are matched to their requests by
+// identifier in whatever order they arrive, and each request is sent again on
+// its own timer until answered or out of retries; a partly received response
+// has only its missing fragments asked for. Timeouts adapt to the round-trip
+// time measured to the server, and retransmissions are limited by a budget.
+// Each request carries the time left until it is given up on, so that the
+// server can drop it rather than serve it too late.
+//
+// A background thread receives from the socket, which nothing else may receive
+// from while the pipeline exists. Safe to use from multiple threads.
+class RequestPipeline {
+ public:
+  using Clock = std::chrono::steady_clock;
+  // Called with the marshalled response, or with nothing if none arrived.
+  using Callback = std::function<void(std::optional<std::vector<std::byte>>)>;
+
+  // Up to window requests may be outstanding at a time.
+  RequestPipeline(DatagramSocket &socket, srpc::SocketAddress server_addr,
+                  RetryPolicy policy = {}, std::size_t window = 64);
+  RequestPipeline(const RequestPipeline &) = delete;
+  RequestPipeline &operator=(const RequestPipeline &) = delete;
+  // Gives up on any outstanding requests.
+  ~RequestPipeline();
+
+  // Sends a marshalled request with the given identifier, blocking while the
+  // window is full. The callback runs on the background thread, and must not
+  // block on other requests of the pipeline.
+  void Send(srpc::u64 id, std::vector<std::byte> req_data, Callback callback);
+
+  // Sends a request under a fresh identifier, and returns its response, or
+  // nothing if none arrived or it could not be unmarshalled.
+  template <typename Req, typename Res>
+  std::future<std::optional<Res>> Call(Req req) {
+    req.id = MakeMessageIdentifier();
+    auto promise = std::make_shared<std::promise<std::optional<Res>>>();
+    auto future = promise->get_future();
+    Send(req.id, srpc::Marshal<Req>{}(req),
+         [promise, id = req.id](auto res_data) {
+           promise->set_value(ToResponse<Res>(id, std::move(res_data)));
+         });
+    return future;
+  }
+
+  // Sends a request under a fresh identifier, and returns an awaitable of its
+  // response, or of nothing as for Call(). The awaiting coroutine is resumed
+  // on the given loop.
+  template <typename Req, typename Res>
+  auto Await(Req req, EventLoop &loop) {
+    struct Awaiter {
+      RequestPipeline &pipeline;
+      EventLoop &loop;
+      srpc::u64 id;
+      std::vector<std::byte> req_data;
+      std::optional<std::vector<std::byte>> res_data;
+
+      [[nodiscard]] bool await_ready() const { return false; }
+
+      void await_suspend(std::coroutine_handle<> handle) {
+        // The coroutine may be resumed, and this destroyed, before Send()
+        // returns, so nothing here is touched after it.
+        pipeline.Send(id, std::move(req_data),
+                      [this, &loop = loop, handle](auto data) {
+                        res_data = std::move(data);
+                        loop.Post(handle);
+                      });
+      }
+
+      std::optional<Res> await_resume() {
+        return ToResponse<Res>(id, std::move(res_data));
+      }
+    };
+    req.id = MakeMessageIdentifier();
+    auto req_data = srpc::Marshal<Req>{}(req);
+    return Awaiter{*this, loop, req.id, std::move(req_data), {}};
+  }
+
+  [[nodiscard]] std::size_t Outstanding() const;
+
+ private:
+  template <typename Res>
+  static std::optional<Res> ToResponse(
+      srpc::u64 id, std::optional<std::vector<std::byte>> res_data) {
+    std::optional<Res> res;
+    if (res_data.has_value()) {
+      res = srpc::Unmarshal<Res>{}(*res_data).second;
+    }
+    if (res.has_value() && res->id != id) {
+      res.reset();
+    }
+    return res;
+  }
+
+  struct Pending {
+    std::vector<std::byte> req_data;
+    Callback callback;
+    FragmentReassembler reassembler;
+    int attempts;
+    // The timeout of the latest transmission, before jitter.
+    RttEstimator::Duration timeout;
+    Clock::time_point sent_at;
+    Clock::time_point retransmit_at;
+    // When the request is given up on. The server is told, so that it does not
+    // serve a request no longer waited for.
+    Clock::time_point give_up_at;
+  };
+
+  using Completion =
+      std::pair<Callback, std::optional<std::vector<std::byte>>>;
+
+  void Run();
+  void Accept(std::vector<std::byte> data,
+              std::vector<Completion> &completions);
+  void Expire(Clock::time_point now, std::vector<Completion> &completions);
+  void Complete(srpc::u64 id, std::optional<std::vector<std::byte>> res_data,
+                std::vector<Completion> &completions);
+  void Transmit(srpc::u64 id, const Pending &pending, Clock::time_point now);
+  // Varies a timeout randomly, as RetryPolicy::jitter allows.
+  Clock::duration Jitter(RttEstimator::Duration timeout);
+
+  DatagramSocket &socket_;
+  srpc::SocketAddress server_addr_;
+  RetryPolicy policy_;
+  std::size_t window_;
+  mutable std::mutex mutex_;
+  std::condition_variable window_cv_;
+  bool stopping_ = false;
+  std::unordered_map<srpc::u64, Pending> pending_;
+  // The next timeouts of the pending requests, earliest first.
+  std::set<std::pair<Clock::time_point, srpc::u64>> timers_;
+  RttEstimator rtt_;
+  RetryBudget retry_budget_;
+  std::minstd_rand rand_;
+  std::thread receiver_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_CLIENT_PIPELINE_H_
@@ -0,0 +1,71 @@
+#include "messages/batch.h"
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <utility>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+std::ostream &operator<<(std::ostream &os, const BatchRequest &request) {
+  os << "[" << request.id << "] Batch of " << request.requests.size()
+     << " request(s)";
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os, const BatchRequestView &request) {
+  os << "[" << request.id << "] Batch of " << request.requests.size()
+     << " request(s)";
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os, const BatchResponse &response) {
+  os << "[" << response.id << "] ";
+  if (response.status_code != 0) {
+    os << "Error: " << response.message;
+  } else {
+    os << "Batch of " << response.responses.size() << " response(s)";
+  }
+  return os;
+}
+
+}  // namespace dfis
+
+namespace srpc {
+
+void Marshal<dfis::BatchRequest>::operator()(const dfis::BatchRequest &request,
+                                             dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
+}
+
+[[nodiscard]] std::pair<i64, std::optional<dfis::BatchRequest>>
+Unmarshal<dfis::BatchRequest>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::BatchRequest>(data);
+}
+
+[[nodiscard]] std::pair<i64, std::optional<dfis::BatchRequestView>>
+Unmarshal<dfis::BatchRequestView>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::BatchRequestView>(data);
+}
+
+void Marshal<dfis::BatchResponse>::operator()(
+    const dfis::BatchResponse &response, dfis::ByteWriter &writer) const {
+  dfis::Encode(response, writer);
+}
+
+[[nodiscard]] std::pair<i64, std::optional<dfis::BatchResponse>>
+Unmarshal<dfis::BatchResponse>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::BatchResponse>(data);
+}
+
+}  // namespace srpc
@@ -0,0 +1,119 @@
+#ifndef DFIS_MESSAGES_BATCH_H_
+#define DFIS_MESSAGES_BATCH_H_
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/message_type.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+// Carries any number of requests, of any types, to be served together in one
+// exchange. Each request keeps an identifier of its own, by which it is
+// deduplicated as if it had been sent alone.
+struct BatchRequest {
+  static constexpr MessageType kMessageType = MessageType::kBatchRequest;
+  srpc::u64 id;
+  // Each a marshalled request.
+  std::vector<std::vector<std::byte>> requests;
+
+  static constexpr auto Fields() {
+    return std::tuple{&BatchRequest::id, &BatchRequest::requests};
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const BatchRequest &request);
+
+// A BatchRequest decoded in place. It refers into the buffer it was decoded
+// from, and is only valid for as long as that buffer is.
+struct BatchRequestView {
+  static constexpr MessageType kMessageType = BatchRequest::kMessageType;
+  srpc::u64 id;
+  std::vector<std::span<const std::byte>> requests;
+
+  static constexpr auto Fields() {
+    return std::tuple{&BatchRequestView::id, &BatchRequestView::requests};
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const BatchRequestView &request);
+
+struct BatchResponse {
+  static constexpr MessageType kMessageType = MessageType::kBatchResponse;
+  srpc::u64 id;
+  srpc::i32 status_code;
+  std::string message;
+  // The marshalled response to each request, in the same order. A request
+  // that could not be served has an empty response.
+  std::vector<std::vector<std::byte>> responses;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &BatchResponse::id,
+        &BatchResponse::status_code,
+        &BatchResponse::message,
+        &BatchResponse::responses,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const BatchResponse &response);
+
+}  // namespace dfis
+
+namespace srpc {
+
+template <>
+struct Marshal<dfis::BatchRequest> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::BatchRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::BatchRequest &request,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::BatchRequest> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::BatchRequest>> operator()(
+      const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Unmarshal<dfis::BatchRequestView> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::BatchRequestView>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Marshal<dfis::BatchResponse> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::BatchResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::BatchResponse &response,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::BatchResponse> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::BatchResponse>> operator()(
+      const std::span<const std::byte> &data) const;
+};
+
+}  // namespace srpc
+
+#endif  // DFIS_MESSAGES_BATCH_H_
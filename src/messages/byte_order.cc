@@ -0,0 +1,143 @@
+#include "messages/byte_order.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DFIS_BYTE_ORDER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace dfis {
+
+namespace {
+
+// A shuffle control reversing the bytes of each width-byte lane of a 16-byte
+// block.
+constexpr std::array<char, 16> SwapMask(std::size_t width) {
+  std::array<char, 16> mask{};
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    mask[i] = static_cast<char>(i / width * width + width - 1 - i % width);
+  }
+  return mask;
+}
+
+constexpr auto kSwap16 = SwapMask(2);
+constexpr auto kSwap32 = SwapMask(4);
+constexpr auto kSwap64 = SwapMask(8);
+
+[[maybe_unused]] const char *SwapMaskFor(std::size_t width) {
+  switch (width) {
+    case 2: return kSwap16.data();
+    case 4: return kSwap32.data();
+    default: return kSwap64.data();
+  }
+}
+
+template <std::size_t W>
+void SwapLanes(const std::byte *in, std::byte *out, std::size_t size) {
+  for (std::size_t offset = 0; offset < size; offset += W) {
+    for (std::size_t i = 0; i < W; ++i) {
+      out[offset + i] = in[offset + W - 1 - i];
+    }
+  }
+}
+
+}  // namespace
+
+namespace byte_order_internal {
+
+void SwapPortable(const std::byte *in, std::byte *out, std::size_t size,
+                  std::size_t width) {
+  switch (width) {
+    case 2: SwapLanes<2>(in, out, size); break;
+    case 4: SwapLanes<4>(in, out, size); break;
+    case 8: SwapLanes<8>(in, out, size); break;
+    default: std::memcpy(out, in, size); break;
+  }
+}
+
+#if defined(DFIS_BYTE_ORDER_X86)
+bool HasSsse3() {
+  static const bool kHas = __builtin_cpu_supports("ssse3");
+  return kHas;
+}
+
+bool HasAvx2() {
+  static const bool kHas = __builtin_cpu_supports("avx2");
+  return kHas;
+}
+
+[[gnu::target("ssse3")]] std::size_t SwapSsse3(const std::byte *in,
+                                               std::byte *out,
+                                               std::size_t size,
+                                               std::size_t width) {
+  auto mask =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(SwapMaskFor(width)));
+  std::size_t offset = 0;
+  for (; offset + 16 <= size; offset += 16) {
+    auto block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + offset),
+                     _mm_shuffle_epi8(block, mask));
+  }
+  return offset;
+}
+
+[[gnu::target("avx2")]] std::size_t SwapAvx2(const std::byte *in,
+                                             std::byte *out, std::size_t size,
+                                             std::size_t width) {
+  // The shuffle works within each 16-byte half, so the same control is used
+  // for both.
+  auto mask = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(SwapMaskFor(width))));
+  std::size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    auto block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + offset));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + offset),
+                        _mm256_shuffle_epi8(block, mask));
+  }
+  return offset;
+}
+#else
+bool HasSsse3() { return false; }
+
+bool HasAvx2() { return false; }
+
+std::size_t SwapSsse3(const std::byte *, std::byte *, std::size_t,
+                      std::size_t) {
+  return 0;
+}
+
+std::size_t SwapAvx2(const std::byte *, std::byte *, std::size_t,
+                     std::size_t) {
+  return 0;
+}
+#endif
+
+}  // namespace byte_order_internal
+
+void ConvertByteOrder(const std::byte *in, std::byte *out, std::size_t count,
+                      std::size_t width) {
+  namespace internal = byte_order_internal;
+  auto size = count * width;
+  if (size == 0) {
+    return;
+  }
+  if (std::endian::native == std::endian::big || width == 1) {
+    std::memcpy(out, in, size);
+    return;
+  }
+  std::size_t done = 0;
+  if (internal::HasAvx2()) {
+    done = internal::SwapAvx2(in, out, size, width);
+  } else if (internal::HasSsse3()) {
+    done = internal::SwapSsse3(in, out, size, width);
+  }
+  internal::SwapPortable(in + done, out + done, size - done, width);
+}
+
+}  // namespace dfis
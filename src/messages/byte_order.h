@@ -0,0 +1,69 @@
+#ifndef DFIS_MESSAGES_BYTE_ORDER_H_
+#define DFIS_MESSAGES_BYTE_ORDER_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+// Bulk conversion of numeric arrays to and from the big-endian encoding srpc
+// uses for scalars, a whole array at a time rather than element by element.
+// Byte swaps use AVX2 or SSSE3 shuffles where the CPU has them, and a portable
+// loop otherwise.
+
+namespace dfis {
+
+// Types whose wire encoding is their object representation in big-endian
+// order. bool is excluded, as not every byte is a valid bool.
+template <typename T>
+concept BulkConvertible = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+// Converts count values of width bytes each between host and big-endian byte
+// order. The conversion is its own inverse. in and out must not overlap.
+void ConvertByteOrder(const std::byte *in, std::byte *out, std::size_t count,
+                      std::size_t width);
+
+template <BulkConvertible T>
+void EncodeBigEndian(std::span<const T> values, std::byte *out) {
+  ConvertByteOrder(reinterpret_cast<const std::byte *>(values.data()), out,
+                   values.size(), sizeof(T));
+}
+
+template <BulkConvertible T>
+void DecodeBigEndian(const std::byte *in, std::span<T> values) {
+  ConvertByteOrder(in, reinterpret_cast<std::byte *>(values.data()),
+                   values.size(), sizeof(T));
+}
+
+// Stores a single value in big-endian order. srpc only marshals a scalar into
+// a new vector, so the codec writes them in place itself.
+template <BulkConvertible T>
+void StoreBigEndian(T value, std::byte *out) {
+  auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+  if constexpr (std::endian::native == std::endian::little) {
+    std::reverse(bytes.begin(), bytes.end());
+  }
+  std::copy(bytes.begin(), bytes.end(), out);
+}
+
+namespace byte_order_internal {
+
+// The individual byte swap kernels, for testing and benchmarking. The vector
+// kernels swap whole blocks only, and return the number of bytes swapped.
+void SwapPortable(const std::byte *in, std::byte *out, std::size_t size,
+                  std::size_t width);
+[[nodiscard]] bool HasSsse3();
+[[nodiscard]] bool HasAvx2();
+std::size_t SwapSsse3(const std::byte *in, std::byte *out, std::size_t size,
+                      std::size_t width);
+std::size_t SwapAvx2(const std::byte *in, std::byte *out, std::size_t size,
+                     std::size_t width);
+
+}  // namespace byte_order_internal
+
+}  // namespace dfis
+
+#endif  // DFIS_MESSAGES_BYTE_ORDER_H_
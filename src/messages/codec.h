@@ -0,0 +1,424 @@
+#ifndef DFIS_MESSAGES_CODEC_H_
+#define DFIS_MESSAGES_CODEC_H_
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/byte_order.h"
+#include "messages/message_type.h"
+#include "messages/wire.h"
+
+// Encoders and decoders generated from the fields a message lists, as a static
+// Fields() returning a tuple of pointers to its members in wire order. A
+// message with a kMessageType is prefixed by it.
+//
+// Fields may be scalars, enums (encoded as their underlying type), strings,
+// string views (decoded in place), raw bytes, and vectors of any of these or
+// of other messages, or of any type with a FieldCodec. Consecutive fixed-width
+// fields form a run, whose bounds are checked once and whose offsets are all
+// known at compile time.
+
+namespace dfis {
+
+template <typename T>
+concept HasFields = requires { T::Fields(); };
+
+template <typename T>
+concept HasMessageType = requires { T::kMessageType; };
+
+// Specialised for field types with an encoding of their own, to provide
+// static Size(const T &), Encode(const T &, ByteWriter &) and
+// Decode(ByteReader &, T &), the latter returning whether it succeeded.
+template <typename T>
+struct FieldCodec;
+
+template <typename T>
+concept HasFieldCodec = requires(const T &value, T &out, ByteWriter &writer,
+                                 ByteReader &reader) {
+  { FieldCodec<T>::Size(value) } -> std::same_as<std::size_t>;
+  FieldCodec<T>::Encode(value, writer);
+  { FieldCodec<T>::Decode(reader, out) } -> std::same_as<bool>;
+};
+
+// Raw bytes, framed by their length.
+template <>
+struct FieldCodec<std::vector<std::byte>> {
+  static std::size_t Size(const std::vector<std::byte> &bytes) {
+    return sizeof(WireLength) + bytes.size();
+  }
+
+  static void Encode(const std::vector<std::byte> &bytes, ByteWriter &writer) {
+    writer.WriteBytes(bytes);
+  }
+
+  static bool Decode(ByteReader &reader, std::vector<std::byte> &bytes) {
+    auto in = reader.ReadBytes();
+    bytes.assign(in.begin(), in.end());
+    return reader.Ok();
+  }
+};
+
+// Raw bytes, decoded in place.
+template <>
+struct FieldCodec<std::span<const std::byte>> {
+  static std::size_t Size(std::span<const std::byte> bytes) {
+    return sizeof(WireLength) + bytes.size();
+  }
+
+  static void Encode(std::span<const std::byte> bytes, ByteWriter &writer) {
+    writer.WriteBytes(bytes);
+  }
+
+  static bool Decode(ByteReader &reader, std::span<const std::byte> &bytes) {
+    bytes = reader.ReadBytes();
+    return reader.Ok();
+  }
+};
+
+template <HasFields M>
+void Encode(const M &message, ByteWriter &writer);
+
+namespace codec_internal {
+
+template <typename T>
+inline constexpr bool kFixedWidth = std::is_arithmetic_v<T> ||
+                                    std::is_enum_v<T>;
+
+template <typename T, bool = std::is_enum_v<T>>
+struct Wire {
+  using Type = T;
+};
+
+template <typename T>
+struct Wire<T, true> {
+  using Type = std::underlying_type_t<T>;
+};
+
+template <typename M>
+inline constexpr auto kFields = M::Fields();
+
+template <typename M>
+inline constexpr std::size_t kFieldCount =
+    std::tuple_size_v<std::remove_const_t<decltype(kFields<M>)>>;
+
+template <typename M, std::size_t I>
+using FieldType = std::remove_cvref_t<decltype(std::declval<const M &>().*
+                                               std::get<I>(kFields<M>))>;
+
+template <typename M, std::size_t I>
+constexpr std::size_t FieldWidth() {
+  if constexpr (kFixedWidth<FieldType<M, I>>) {
+    return sizeof(typename Wire<FieldType<M, I>>::Type);
+  } else {
+    return 0;
+  }
+}
+
+// The encoded width of each field, or 0 for those of variable width.
+template <typename M>
+inline constexpr auto kWidths = []<std::size_t... I>(
+                                    std::index_sequence<I...>) {
+  return std::array<std::size_t, sizeof...(I)>{FieldWidth<M, I>()...};
+}(std::make_index_sequence<kFieldCount<M>>{});
+
+// The end of the run of fixed-width fields starting at begin.
+template <typename M>
+constexpr std::size_t RunEnd(std::size_t begin) {
+  while (begin < kFieldCount<M> && kWidths<M>[begin] != 0) {
+    ++begin;
+  }
+  return begin;
+}
+
+template <typename M>
+constexpr std::size_t Offset(std::size_t begin, std::size_t end) {
+  std::size_t offset = 0;
+  for (auto i = begin; i < end; ++i) {
+    offset += kWidths<M>[i];
+  }
+  return offset;
+}
+
+template <typename T>
+void Store(std::byte *out, T value) {
+  using W = typename Wire<T>::Type;
+  StoreBigEndian(static_cast<W>(value), out);
+}
+
+template <typename T>
+[[nodiscard]] T Load(const std::byte *in) {
+  using W = typename Wire<T>::Type;
+  return static_cast<T>(srpc::Unmarshal<W>{}(
+      std::span<const std::byte, sizeof(W)>{in, in + sizeof(W)}));
+}
+
+// Stores the fixed-width fields in [Begin, End) from out onwards.
+template <typename M, std::size_t Begin, std::size_t End>
+void StoreRun(const M &message, std::byte *out) {
+  [&]<std::size_t... K>(std::index_sequence<K...>) {
+    (Store(out + Offset<M>(Begin, Begin + K),
+           message.*std::get<Begin + K>(kFields<M>)),
+     ...);
+  }(std::make_index_sequence<End - Begin>{});
+}
+
+template <typename T>
+void EncodeVariable(const T &field, ByteWriter &writer);
+
+// Encodes an element of a vector, which may be a message of its own.
+template <typename T>
+void EncodeElement(const T &element, ByteWriter &writer) {
+  if constexpr (HasFields<T>) {
+    Encode(element, writer);
+  } else {
+    EncodeVariable(element, writer);
+  }
+}
+
+template <typename T>
+void EncodeVariable(const T &field, ByteWriter &writer) {
+  if constexpr (HasFieldCodec<T>) {
+    FieldCodec<T>::Encode(field, writer);
+  } else if constexpr (std::is_same_v<T, std::string> ||
+                       std::is_same_v<T, std::string_view>) {
+    writer.Write(std::string_view{field});
+  } else if constexpr (kFixedWidth<typename T::value_type>) {
+    writer.Write(field);
+  } else {
+    writer.WriteLength(field.size());
+    for (const auto &element : field) {
+      EncodeElement(element, writer);
+    }
+  }
+}
+
+template <typename M, std::size_t I>
+void EncodeFrom(const M &message, ByteWriter &writer) {
+  if constexpr (I < kFieldCount<M>) {
+    if constexpr (kWidths<M>[I] == 0) {
+      EncodeVariable(message.*std::get<I>(kFields<M>), writer);
+      EncodeFrom<M, I + 1>(message, writer);
+    } else {
+      constexpr auto kEnd = RunEnd<M>(I);
+      auto *out = writer.Reserve(Offset<M>(I, kEnd));
+      if (out != nullptr) {
+        StoreRun<M, I, kEnd>(message, out);
+      }
+      EncodeFrom<M, kEnd>(message, writer);
+    }
+  }
+}
+
+template <typename M>
+bool DecodeInto(ByteReader &reader, M &message);
+
+template <typename T>
+void DecodeVariable(ByteReader &reader, T &field) {
+  if constexpr (HasFieldCodec<T>) {
+    if (!FieldCodec<T>::Decode(reader, field)) {
+      reader.Fail();
+    }
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    field = std::string{reader.ReadString()};
+  } else if constexpr (std::is_same_v<T, std::string_view>) {
+    field = reader.ReadString();
+  } else {
+    using E = typename T::value_type;
+    auto length = reader.Read<WireLength>();
+    if constexpr (kFixedWidth<E>) {
+      constexpr auto kWidth = sizeof(typename Wire<E>::Type);
+      const auto *in = reader.Consume(std::size_t{length} * kWidth);
+      if (in == nullptr) {
+        return;
+      }
+      if constexpr (BulkConvertible<E>) {
+        field.resize(length);
+        DecodeBigEndian(in, std::span<E>{field});
+        return;
+      }
+      field.reserve(length);
+      for (WireLength i = 0; i < length; ++i) {
+        field.push_back(Load<E>(in + i * kWidth));
+      }
+    } else {
+      for (WireLength i = 0; i < length && reader.Ok(); ++i) {
+        E element{};
+        if constexpr (HasFields<E>) {
+          if (!DecodeInto(reader, element)) {
+            reader.Fail();
+          }
+        } else {
+          DecodeVariable(reader, element);
+        }
+        if (reader.Ok()) {
+          field.push_back(std::move(element));
+        }
+      }
+    }
+  }
+}
+
+template <typename M, std::size_t I>
+void DecodeFrom(ByteReader &reader, M &message) {
+  if constexpr (I < kFieldCount<M>) {
+    if constexpr (kWidths<M>[I] == 0) {
+      DecodeVariable(reader, message.*std::get<I>(kFields<M>));
+      DecodeFrom<M, I + 1>(reader, message);
+    } else {
+      constexpr auto kEnd = RunEnd<M>(I);
+      const auto *in = reader.Consume(Offset<M>(I, kEnd));
+      if (in == nullptr) {
+        return;
+      }
+      [&]<std::size_t... K>(std::index_sequence<K...>) {
+        ((message.*std::get<I + K>(kFields<M>) =
+              Load<FieldType<M, I + K>>(in + Offset<M>(I, I + K))),
+         ...);
+      }(std::make_index_sequence<kEnd - I>{});
+      DecodeFrom<M, kEnd>(reader, message);
+    }
+  }
+}
+
+template <typename M>
+bool DecodeInto(ByteReader &reader, M &message) {
+  if constexpr (HasMessageType<M>) {
+    if (MessageType{reader.Read<srpc::i32>()} != M::kMessageType) {
+      return false;
+    }
+  }
+  DecodeFrom<M, 0>(reader, message);
+  return reader.Ok();
+}
+
+}  // namespace codec_internal
+
+// Messages made up of fixed-width fields only, which encode to the same size
+// whatever their contents.
+template <typename M>
+concept FixedLayout =
+    HasFields<M> &&
+    codec_internal::RunEnd<M>(0) == codec_internal::kFieldCount<M>;
+
+template <HasFields M>
+inline constexpr std::size_t kPrefixSize =
+    HasMessageType<M> ? sizeof(srpc::i32) : 0;
+
+template <FixedLayout M>
+inline constexpr std::size_t kSerializedSize =
+    kPrefixSize<M> +
+    codec_internal::Offset<M>(0, codec_internal::kFieldCount<M>);
+
+template <HasFields M>
+[[nodiscard]] constexpr std::size_t SerializedSize(const M &message);
+
+namespace codec_internal {
+
+template <typename T>
+constexpr std::size_t VariableSize(const T &field) {
+  if constexpr (HasFieldCodec<T>) {
+    return FieldCodec<T>::Size(field);
+  } else if constexpr (std::is_same_v<T, std::string> ||
+                       std::is_same_v<T, std::string_view>) {
+    return sizeof(WireLength) + field.size();
+  } else {
+    using E = typename T::value_type;
+    if constexpr (kFixedWidth<E>) {
+      return sizeof(WireLength) +
+             field.size() * sizeof(typename Wire<E>::Type);
+    } else {
+      auto size = sizeof(WireLength);
+      for (const auto &element : field) {
+        if constexpr (HasFields<E>) {
+          size += SerializedSize(element);
+        } else {
+          size += VariableSize(element);
+        }
+      }
+      return size;
+    }
+  }
+}
+
+template <typename M, std::size_t I>
+constexpr std::size_t FieldSize(const M &message) {
+  if constexpr (kWidths<M>[I] == 0) {
+    return VariableSize(message.*std::get<I>(kFields<M>));
+  } else {
+    return kWidths<M>[I];
+  }
+}
+
+}  // namespace codec_internal
+
+// The exact number of bytes Encode writes for the message. A constant for
+// fixed-layout messages; otherwise a pass over the variable-width fields.
+template <HasFields M>
+constexpr std::size_t SerializedSize(const M &message) {
+  if constexpr (FixedLayout<M>) {
+    return kSerializedSize<M>;
+  } else {
+    return kPrefixSize<M> + [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return (codec_internal::FieldSize<M, I>(message) + ...);
+    }(std::make_index_sequence<codec_internal::kFieldCount<M>>{});
+  }
+}
+
+template <HasFields M>
+void Encode(const M &message, ByteWriter &writer) {
+  if constexpr (FixedLayout<M>) {
+    // The prefix and every field are written with a single reservation.
+    auto *out = writer.Reserve(kSerializedSize<M>);
+    if (out == nullptr) {
+      return;
+    }
+    if constexpr (HasMessageType<M>) {
+      codec_internal::Store(out, static_cast<srpc::i32>(M::kMessageType));
+    }
+    codec_internal::StoreRun<M, 0, codec_internal::kFieldCount<M>>(
+        message, out + kPrefixSize<M>);
+  } else {
+    if constexpr (HasMessageType<M>) {
+      writer.Write(static_cast<srpc::i32>(M::kMessageType));
+    }
+    codec_internal::EncodeFrom<M, 0>(message, writer);
+  }
+}
+
+// Decodes a message in the manner of srpc::Unmarshal.
+template <HasFields M>
+[[nodiscard]] std::pair<srpc::i64, std::optional<M>> Decode(
+    std::span<const std::byte> data) {
+  ByteReader reader{data};
+  M message{};
+  if (!codec_internal::DecodeInto(reader, message)) {
+    return {0, {}};
+  }
+  return {static_cast<srpc::i64>(reader.Position()), std::move(message)};
+}
+
+// Marshals into a vector allocated once, at exactly the size needed.
+template <HasFields M>
+[[nodiscard]] std::vector<std::byte> MarshalToVector(const M &message) {
+  std::vector<std::byte> data;
+  data.reserve(SerializedSize(message));
+  ByteWriter writer{data};
+  Encode(message, writer);
+  return data;
+}
+
+}  // namespace dfis
+
+#endif  // DFIS_MESSAGES_CODEC_H_
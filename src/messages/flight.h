@@ -5,6 +5,7 @@
 #include <optional>
 #include <span>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -12,6 +13,9 @@
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/codec.h"
+#include "messages/wire.h"
+
 namespace dfis {
 
 struct Flight {
@@ -22,6 +26,17 @@ struct Flight {
   srpc::f32 airfare;
   srpc::i32 seat_availability;
 
+  static constexpr auto Fields() {
+    return std::tuple{
+        &Flight::identifier,
+        &Flight::source,
+        &Flight::destination,
+        &Flight::departure_time,
+        &Flight::airfare,
+        &Flight::seat_availability,
+    };
+  }
+
   [[nodiscard]] bool operator==(const Flight &other) const;
 };
 
@@ -34,7 +49,11 @@ namespace srpc {
 template <>
 struct Marshal<dfis::Flight> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::Flight &flight) const;
+      const dfis::Flight &flight) const {
+    return dfis::MarshalToVector(flight);
+  }
+
+  void operator()(const dfis::Flight &flight, dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -6,14 +6,17 @@
 #include <ostream>
 #include <span>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/codec.h"
 #include "messages/flight.h"
 #include "messages/message_type.h"
+#include "messages/wire.h"
 
 namespace dfis {
 
@@ -21,6 +24,10 @@ struct FlightInfoRequest {
   static constexpr MessageType kMessageType = MessageType::kFlightInfoRequest;
   srpc::u64 id;
   srpc::i32 identifier;
+
+  static constexpr auto Fields() {
+    return std::tuple{&FlightInfoRequest::id, &FlightInfoRequest::identifier};
+  }
 };
 
 std::ostream &operator<<(std::ostream &os, const FlightInfoRequest &request);
@@ -31,6 +38,15 @@ struct FlightInfoResponse {
   srpc::i32 status_code;
   std::string message;
   std::vector<dfis::Flight> flight;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &FlightInfoResponse::id,
+        &FlightInfoResponse::status_code,
+        &FlightInfoResponse::message,
+        &FlightInfoResponse::flight,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os, const FlightInfoResponse &response);
@@ -42,7 +58,12 @@ namespace srpc {
 template <>
 struct Marshal<dfis::FlightInfoRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::FlightInfoRequest &request) const;
+      const dfis::FlightInfoRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::FlightInfoRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -54,7 +75,12 @@ struct Unmarshal<dfis::FlightInfoRequest> {
 template <>
 struct Marshal<dfis::FlightInfoResponse> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::FlightInfoResponse &response) const;
+      const dfis::FlightInfoResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::FlightInfoResponse &response,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
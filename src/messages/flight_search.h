@@ -6,6 +6,8 @@
 #include <ostream>
 #include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -13,7 +15,10 @@
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/codec.h"
+#include "messages/id_list.h"
 #include "messages/message_type.h"
+#include "messages/wire.h"
 
 namespace dfis {
 
@@ -22,39 +27,126 @@ struct FlightSearchRequest {
   srpc::u64 id;
   std::string source;
   std::string destination;
+  // The encoding the response should list flights in.
+  IdListEncoding encoding;
+  // The most flights to return, or 0 for all of them.
+  srpc::u32 page_size;
+  // Where to resume: 0 for the first page, or the next_cursor of the previous
+  // page. Opaque to clients.
+  srpc::u64 cursor;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &FlightSearchRequest::id,
+        &FlightSearchRequest::source,
+        &FlightSearchRequest::destination,
+        &FlightSearchRequest::encoding,
+        &FlightSearchRequest::page_size,
+        &FlightSearchRequest::cursor,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os, const FlightSearchRequest &request);
 
+// A FlightSearchRequest decoded in place. It refers into the buffer it was
+// decoded from, and is only valid for as long as that buffer is.
+struct FlightSearchRequestView {
+  static constexpr MessageType kMessageType = FlightSearchRequest::kMessageType;
+  srpc::u64 id;
+  std::string_view source;
+  std::string_view destination;
+  IdListEncoding encoding;
+  srpc::u32 page_size;
+  srpc::u64 cursor;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &FlightSearchRequestView::id,
+        &FlightSearchRequestView::source,
+        &FlightSearchRequestView::destination,
+        &FlightSearchRequestView::encoding,
+        &FlightSearchRequestView::page_size,
+        &FlightSearchRequestView::cursor,
+    };
+  }
+
+  [[nodiscard]] FlightSearchRequest ToRequest() const;
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const FlightSearchRequestView &request);
+
 struct FlightSearchResponse {
   static constexpr MessageType kMessageType =
       MessageType::kFlightSearchResponse;
   srpc::u64 id;
   srpc::i32 status_code;
   std::string message;
-  std::vector<srpc::i32> flights;
+  IdList flights;
+  // The cursor of the next page, or 0 if this is the last one.
+  srpc::u64 next_cursor;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &FlightSearchResponse::id,
+        &FlightSearchResponse::status_code,
+        &FlightSearchResponse::message,
+        &FlightSearchResponse::flights,
+        &FlightSearchResponse::next_cursor,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
                          const FlightSearchResponse &response);
 
 struct PriceRangeSearchRequest {
-  static constexpr MessageType kMessageType = MessageType::kFlightSearchRequest;
+  static constexpr MessageType kMessageType =
+      MessageType::kPriceRangeSearchRequest;
   srpc::u64 id;
   srpc::f32 from;
   srpc::f32 to;
+  // The encoding the response should list flights in.
+  IdListEncoding encoding;
+  // As in FlightSearchRequest.
+  srpc::u32 page_size;
+  srpc::u64 cursor;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &PriceRangeSearchRequest::id,
+        &PriceRangeSearchRequest::from,
+        &PriceRangeSearchRequest::to,
+        &PriceRangeSearchRequest::encoding,
+        &PriceRangeSearchRequest::page_size,
+        &PriceRangeSearchRequest::cursor,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
                          const PriceRangeSearchRequest &request);
 
+// Flights are listed in ascending order of airfare.
 struct PriceRangeSearchResponse {
   static constexpr MessageType kMessageType =
-      MessageType::kFlightSearchResponse;
+      MessageType::kPriceRangeSearchResponse;
   srpc::u64 id;
   srpc::i32 status_code;
   std::string message;
-  std::vector<srpc::i32> flights;
+  IdList flights;
+  srpc::u64 next_cursor;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &PriceRangeSearchResponse::id,
+        &PriceRangeSearchResponse::status_code,
+        &PriceRangeSearchResponse::message,
+        &PriceRangeSearchResponse::flights,
+        &PriceRangeSearchResponse::next_cursor,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
@@ -67,7 +159,12 @@ namespace srpc {
 template <>
 struct Marshal<dfis::FlightSearchRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::FlightSearchRequest &request) const;
+      const dfis::FlightSearchRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::FlightSearchRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -76,10 +173,21 @@ struct Unmarshal<dfis::FlightSearchRequest> {
   operator()(const std::span<const std::byte> &data) const;
 };
 
+template <>
+struct Unmarshal<dfis::FlightSearchRequestView> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::FlightSearchRequestView>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
 template <>
 struct Marshal<dfis::FlightSearchResponse> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::FlightSearchResponse &response) const;
+      const dfis::FlightSearchResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::FlightSearchResponse &response,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -91,7 +199,12 @@ struct Unmarshal<dfis::FlightSearchResponse> {
 template <>
 struct Marshal<dfis::PriceRangeSearchRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::PriceRangeSearchRequest &request) const;
+      const dfis::PriceRangeSearchRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::PriceRangeSearchRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -103,7 +216,12 @@ struct Unmarshal<dfis::PriceRangeSearchRequest> {
 template <>
 struct Marshal<dfis::PriceRangeSearchResponse> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::PriceRangeSearchResponse &response) const;
+      const dfis::PriceRangeSearchResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::PriceRangeSearchResponse &response,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
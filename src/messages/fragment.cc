@@ -0,0 +1,58 @@
+#include "messages/fragment.h"
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <utility>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+std::ostream &operator<<(std::ostream &os, const Fragment &fragment) {
+  os << "[" << fragment.request_id << "] Fragment " << fragment.index + 1
+     << " of " << fragment.count << " of " << fragment.message_id << " ("
+     << fragment.payload.size() << " byte(s))";
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const FragmentRetransmitRequest &request) {
+  os << "Retransmit " << request.missing.size() << " fragment(s) of "
+     << request.message_id;
+  return os;
+}
+
+}  // namespace dfis
+
+namespace srpc {
+
+void Marshal<dfis::Fragment>::operator()(const dfis::Fragment &fragment,
+                                         dfis::ByteWriter &writer) const {
+  dfis::Encode(fragment, writer);
+}
+
+[[nodiscard]] std::pair<i64, std::optional<dfis::Fragment>>
+Unmarshal<dfis::Fragment>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::Fragment>(data);
+}
+
+void Marshal<dfis::FragmentRetransmitRequest>::operator()(
+    const dfis::FragmentRetransmitRequest &request,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
+}
+
+[[nodiscard]] std::pair<i64, std::optional<dfis::FragmentRetransmitRequest>>
+Unmarshal<dfis::FragmentRetransmitRequest>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::FragmentRetransmitRequest>(data);
+}
+
+}  // namespace srpc
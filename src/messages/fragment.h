@@ -0,0 +1,104 @@
+#ifndef DFIS_MESSAGES_FRAGMENT_H_
+#define DFIS_MESSAGES_FRAGMENT_H_
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/message_type.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+// One of count pieces of a response too large for a single datagram. Every
+// response split is given a fresh message_id, so that the pieces of responses
+// to the same request, executed more than once, are never mixed.
+struct Fragment {
+  static constexpr MessageType kMessageType = MessageType::kFragment;
+  srpc::u64 request_id;
+  srpc::u64 message_id;
+  srpc::u16 index;
+  srpc::u16 count;
+  // Refers to the datagram the fragment was decoded from.
+  std::span<const std::byte> payload;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &Fragment::request_id,
+        &Fragment::message_id,
+        &Fragment::index,
+        &Fragment::count,
+        &Fragment::payload,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const Fragment &fragment);
+
+// Asks for the fragments of a response that have not arrived to be sent again.
+struct FragmentRetransmitRequest {
+  static constexpr MessageType kMessageType =
+      MessageType::kFragmentRetransmitRequest;
+  srpc::u64 message_id;
+  std::vector<srpc::u16> missing;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &FragmentRetransmitRequest::message_id,
+        &FragmentRetransmitRequest::missing,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const FragmentRetransmitRequest &request);
+
+}  // namespace dfis
+
+namespace srpc {
+
+template <>
+struct Marshal<dfis::Fragment> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::Fragment &fragment) const {
+    return dfis::MarshalToVector(fragment);
+  }
+
+  void operator()(const dfis::Fragment &fragment,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::Fragment> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::Fragment>> operator()(
+      const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Marshal<dfis::FragmentRetransmitRequest> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::FragmentRetransmitRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::FragmentRetransmitRequest &request,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::FragmentRetransmitRequest> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::FragmentRetransmitRequest>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+}  // namespace srpc
+
+#endif  // DFIS_MESSAGES_FRAGMENT_H_
@@ -0,0 +1,202 @@
+#include "messages/id_list.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <srpc/types/integers.h>
+
+#include "messages/byte_order.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+namespace {
+
+// The most bytes a zigzag-encoded difference of two i32s takes as a varint.
+constexpr std::size_t kMaxVarintSize = 5;
+
+srpc::u64 ZigZag(srpc::i64 value) {
+  return (static_cast<srpc::u64>(value) << 1) ^
+         static_cast<srpc::u64>(value >> 63);
+}
+
+srpc::i64 UnZigZag(srpc::u64 value) {
+  return static_cast<srpc::i64>(value >> 1) ^
+         -static_cast<srpc::i64>(value & 1);
+}
+
+std::size_t VarintSize(srpc::u64 value) {
+  return (std::bit_width(value | 1) + 6) / 7;
+}
+
+// Appends a decoded difference, and returns false if it leaves the range of
+// identifiers.
+bool Append(srpc::i64 &previous, srpc::u64 zigzag,
+            std::vector<srpc::i32> &ids) {
+  previous += UnZigZag(zigzag);
+  if (previous < std::numeric_limits<srpc::i32>::min() ||
+      previous > std::numeric_limits<srpc::i32>::max()) {
+    return false;
+  }
+  ids.push_back(static_cast<srpc::i32>(previous));
+  return true;
+}
+
+// Checks whether the next block of bytes are all single-byte varints, i.e.
+// none has its continuation bit set.
+#if defined(__SSE2__)
+constexpr std::size_t kBlockSize = 16;
+
+bool IsShortBlock(const std::byte *in) {
+  auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+  return _mm_movemask_epi8(block) == 0;
+}
+#else
+constexpr std::size_t kBlockSize = 8;
+
+bool IsShortBlock(const std::byte *in) {
+  std::uint64_t block;
+  std::memcpy(&block, in, sizeof(block));
+  return (block & 0x8080808080808080) == 0;
+}
+#endif
+
+}  // namespace
+
+bool IsValidIdListEncoding(srpc::i8 encoding) {
+  return encoding >= static_cast<srpc::i8>(IdListEncoding::kFixed) &&
+         encoding <= static_cast<srpc::i8>(IdListEncoding::kDeltaVarint);
+}
+
+std::ostream &operator<<(std::ostream &os, IdListEncoding encoding) {
+  switch (encoding) {
+    case IdListEncoding::kFixed: return os << "fixed";
+    case IdListEncoding::kDeltaVarint: return os << "delta varint";
+  }
+  return os << "unknown encoding " << static_cast<int>(encoding);
+}
+
+void EncodeDeltaVarints(std::span<const srpc::i32> ids, ByteWriter &writer) {
+  auto *out = writer.Reserve(DeltaVarintsSize(ids));
+  if (out == nullptr) {
+    return;
+  }
+  srpc::i64 previous = 0;
+  for (auto id : ids) {
+    auto value = ZigZag(id - previous);
+    previous = id;
+    while (value >= 0x80) {
+      *out++ = static_cast<std::byte>(value | 0x80);
+      value >>= 7;
+    }
+    *out++ = static_cast<std::byte>(value);
+  }
+}
+
+std::size_t DeltaVarintsSize(std::span<const srpc::i32> ids) {
+  std::size_t size = 0;
+  srpc::i64 previous = 0;
+  for (auto id : ids) {
+    size += VarintSize(ZigZag(id - previous));
+    previous = id;
+  }
+  return size;
+}
+
+bool DecodeDeltaVarints(std::span<const std::byte> data, std::size_t count,
+                        std::vector<srpc::i32> &ids) {
+  // Every identifier takes at least a byte.
+  if (count > data.size()) {
+    return false;
+  }
+  ids.reserve(ids.size() + count);
+  srpc::i64 previous = 0;
+  std::size_t p = 0;
+  while (count > 0) {
+    // Fast path: a whole block of small differences, one byte each, as in a
+    // sorted list of nearby identifiers.
+    if (count >= kBlockSize && data.size() - p >= kBlockSize &&
+        IsShortBlock(data.data() + p)) {
+      for (std::size_t i = 0; i < kBlockSize; ++i) {
+        if (!Append(previous, static_cast<srpc::u64>(data[p + i]), ids)) {
+          return false;
+        }
+      }
+      p += kBlockSize;
+      count -= kBlockSize;
+      continue;
+    }
+
+    srpc::u64 value = 0;
+    for (std::size_t shift = 0;; shift += 7) {
+      if (p == data.size() || shift == 7 * kMaxVarintSize) {
+        return false;
+      }
+      auto byte = static_cast<srpc::u64>(data[p++]);
+      value |= (byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        break;
+      }
+    }
+    if (!Append(previous, value, ids)) {
+      return false;
+    }
+    --count;
+  }
+  return p == data.size();
+}
+
+std::size_t FieldCodec<IdList>::Size(const IdList &list) {
+  std::size_t size = sizeof(srpc::i8) + sizeof(WireLength);
+  if (list.encoding == IdListEncoding::kDeltaVarint) {
+    return size + sizeof(WireLength) + DeltaVarintsSize(list.ids);
+  }
+  return size + list.ids.size() * sizeof(srpc::i32);
+}
+
+void FieldCodec<IdList>::Encode(const IdList &list, ByteWriter &writer) {
+  if (list.encoding == IdListEncoding::kDeltaVarint) {
+    writer.Write(static_cast<srpc::i8>(IdListEncoding::kDeltaVarint));
+    writer.WriteLength(list.ids.size());
+    writer.WriteLength(DeltaVarintsSize(list.ids));
+    EncodeDeltaVarints(list.ids, writer);
+  } else {
+    writer.Write(static_cast<srpc::i8>(IdListEncoding::kFixed));
+    writer.Write(list.ids);
+  }
+}
+
+bool FieldCodec<IdList>::Decode(ByteReader &reader, IdList &list) {
+  auto encoding = reader.Read<srpc::i8>();
+  if (!IsValidIdListEncoding(encoding)) {
+    return false;
+  }
+  list.encoding = IdListEncoding{encoding};
+  auto count = reader.Read<WireLength>();
+  if (list.encoding == IdListEncoding::kDeltaVarint) {
+    auto size = reader.Read<WireLength>();
+    const auto *in = reader.Consume(size);
+    return in != nullptr &&
+           DecodeDeltaVarints(std::span<const std::byte>{in, size}, count,
+                              list.ids);
+  }
+  const auto *in = reader.Consume(std::size_t{count} * sizeof(srpc::i32));
+  if (in == nullptr) {
+    return false;
+  }
+  list.ids.resize(count);
+  DecodeBigEndian(in, std::span<srpc::i32>{list.ids});
+  return true;
+}
+
+}  // namespace dfis
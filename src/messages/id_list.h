@@ -0,0 +1,59 @@
+#ifndef DFIS_MESSAGES_ID_LIST_H_
+#define DFIS_MESSAGES_ID_LIST_H_
+
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include <srpc/types/integers.h>
+
+#include "messages/codec.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+// How a list of identifiers is sent. A request names the encoding it would
+// like its response to use.
+enum class IdListEncoding : srpc::i8 {
+  // Each identifier as a fixed-width integer.
+  kFixed = 0,
+  // The differences between consecutive identifiers, zigzag-encoded as LEB128
+  // varints. Sorted lists of nearby identifiers take about a byte each.
+  kDeltaVarint = 1,
+};
+
+[[nodiscard]] bool IsValidIdListEncoding(srpc::i8 encoding);
+
+std::ostream &operator<<(std::ostream &os, IdListEncoding encoding);
+
+struct IdList {
+  IdListEncoding encoding;
+  std::vector<srpc::i32> ids;
+
+  bool operator==(const IdList &other) const = default;
+};
+
+// Appends the identifiers as delta-coded varints.
+void EncodeDeltaVarints(std::span<const srpc::i32> ids, ByteWriter &writer);
+
+// The number of bytes EncodeDeltaVarints writes.
+[[nodiscard]] std::size_t DeltaVarintsSize(std::span<const srpc::i32> ids);
+
+// Decodes exactly count identifiers from all of data, appending them to ids.
+// Returns false if data is malformed, or holds more or fewer identifiers.
+bool DecodeDeltaVarints(std::span<const std::byte> data, std::size_t count,
+                        std::vector<srpc::i32> &ids);
+
+// An encoding byte, the number of identifiers, and then either the
+// identifiers, or the length in bytes of their varints followed by them.
+template <>
+struct FieldCodec<IdList> {
+  static std::size_t Size(const IdList &list);
+  static void Encode(const IdList &list, ByteWriter &writer);
+  static bool Decode(ByteReader &reader, IdList &list);
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_MESSAGES_ID_LIST_H_
@@ -1,6 +1,8 @@
 #ifndef DFIS_MESSAGES_MESSAGE_TYPE_H_
 #define DFIS_MESSAGES_MESSAGE_TYPE_H_
 
+#include <tuple>
+
 #include <srpc/types/integers.h>
 
 namespace dfis {
@@ -15,11 +17,32 @@ enum class MessageType : srpc::i32 {
   kSeatAvailabilityMonitoringRequest = 7,
   kSeatAvailabilityMonitoringResponse = 8,
   kSeatAvailabilityCallbackRequest = 9,
-  kSeatAvailabilityCallbackResponse = 10,
   kPriceRangeSearchRequest = 11,
   kPriceRangeSearchResponse = 12,
   kSeatReservationCancellationRequest = 13,
   kSeatReservationCancellationResponse = 14,
+  kRouteMonitoringRequest = 15,
+  kRouteMonitoringResponse = 16,
+  kSeatAvailabilitySnapshotRequest = 17,
+  kSeatAvailabilitySnapshotResponse = 18,
+  kMulticastMonitoringRequest = 19,
+  kMulticastMonitoringResponse = 20,
+  kFragment = 21,
+  kFragmentRetransmitRequest = 22,
+  kBatchRequest = 23,
+  kBatchResponse = 24,
+  kTimedRequest = 25,
+};
+
+// The type and identifier every message starts with, for handling a marshalled
+// message without knowing its type.
+struct MessageHeader {
+  srpc::i32 type;
+  srpc::u64 id;
+
+  static constexpr auto Fields() {
+    return std::tuple{&MessageHeader::type, &MessageHeader::id};
+  }
 };
 
 }  // namespace dfis
@@ -5,23 +5,73 @@
 #include <ostream>
 #include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
-#include <srpc/types/strings.h>
-#include <srpc/types/vectors.h>
 
-#include "messages/message_type.h"
+#include "messages/codec.h"
+#include "messages/wire.h"
 #include "utils/time.h"
 
 namespace dfis {
 
+namespace {
+
+template <typename Request>
+void PrintRouteMonitoringRequest(std::ostream &os, const Request &request) {
+  os << "[" << request.id << "] " << request.source << " -> "
+     << request.destination;
+  if (request.departure_from != 0 || request.departure_to != 0) {
+    os << " departing " << FormatTimestamp(request.departure_from) << " to ";
+    if (request.departure_to != 0) {
+      os << FormatTimestamp(request.departure_to);
+    } else {
+      os << "any time";
+    }
+  }
+  os << " @ port " << request.port << " (" << request.monitor_interval_sec
+     << "s";
+  if (request.coalesce_window_ms > 0) {
+    os << ", coalescing " << request.coalesce_window_ms << "ms";
+  }
+  if (request.trigger != SeatAvailabilityTrigger::kEveryChange) {
+    os << ", when " << request.trigger << " " << request.threshold;
+  }
+  os << ")";
+}
+
+}  // namespace
+
+bool IsValidSeatAvailabilityTrigger(srpc::i8 trigger) {
+  return trigger >= static_cast<srpc::i8>(
+                        SeatAvailabilityTrigger::kEveryChange) &&
+         trigger <= static_cast<srpc::i8>(SeatAvailabilityTrigger::kCrosses);
+}
+
+std::ostream &operator<<(std::ostream &os, SeatAvailabilityTrigger trigger) {
+  switch (trigger) {
+    case SeatAvailabilityTrigger::kEveryChange: return os << "every change";
+    case SeatAvailabilityTrigger::kFallsBelow: return os << "falls below";
+    case SeatAvailabilityTrigger::kRisesTo: return os << "rises to";
+    case SeatAvailabilityTrigger::kCrosses: return os << "crosses";
+  }
+  return os << "unknown trigger " << static_cast<int>(trigger);
+}
+
 std::ostream &operator<<(std::ostream &os,
                          const SeatAvailabilityMonitoringRequest &request) {
   os << "[" << request.id << "] " << request.identifier << " @ port "
-     << request.port << " (" << request.monitor_interval_sec << "s)";
+     << request.port << " (" << request.monitor_interval_sec << "s";
+  if (request.coalesce_window_ms > 0) {
+    os << ", coalescing " << request.coalesce_window_ms << "ms";
+  }
+  if (request.trigger != SeatAvailabilityTrigger::kEveryChange) {
+    os << ", when " << request.trigger << " " << request.threshold;
+  }
+  os << ")";
   return os;
 }
 
@@ -32,325 +82,229 @@ std::ostream &operator<<(std::ostream &os,
     os << "Error: " << response.message;
   } else {
     os << "Monitoring " << response.identifier << " until "
-       << FormatTimestamp(response.monitor_end);
+       << FormatTimestamp(response.monitor_end) << " as subscription "
+       << response.subscription;
   }
   return os;
 }
 
 std::ostream &operator<<(std::ostream &os,
-                         const SeatAvailabilityCallbackRequest &request) {
-  os << "[" << request.id << "] " << request.identifier << " ("
-     << request.seat_availability << " seat(s) avail.)";
+                         const RouteMonitoringRequest &request) {
+  PrintRouteMonitoringRequest(os, request);
+  return os;
+}
+
+RouteMonitoringRequest RouteMonitoringRequestView::ToRequest() const {
+  return RouteMonitoringRequest{
+      .id = id,
+      .source = std::string{source},
+      .destination = std::string{destination},
+      .departure_from = departure_from,
+      .departure_to = departure_to,
+      .port = port,
+      .monitor_interval_sec = monitor_interval_sec,
+      .coalesce_window_ms = coalesce_window_ms,
+      .trigger = trigger,
+      .threshold = threshold,
+  };
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const RouteMonitoringRequestView &request) {
+  PrintRouteMonitoringRequest(os, request);
   return os;
 }
 
 std::ostream &operator<<(std::ostream &os,
-                         const SeatAvailabilityCallbackResponse &response) {
+                         const RouteMonitoringResponse &response) {
   os << "[" << response.id << "] ";
   if (response.status_code != 0) {
-    os << "Some error(s) occurred in the callback loop";
+    os << "Error: " << response.message;
   } else {
-    os << "Callback is completed successfully";
+    os << "Monitoring {";
+    bool is_first = true;
+    for (const auto &flight : response.flights) {
+      if (is_first) {
+        is_first = false;
+      } else {
+        os << ", ";
+      }
+      os << flight;
+    }
+    os << "} until " << FormatTimestamp(response.monitor_end)
+       << " as subscription " << response.subscription;
   }
   return os;
 }
 
-}  // namespace dfis
-
-namespace srpc {
+std::ostream &operator<<(std::ostream &os,
+                         const SeatAvailabilityCallbackRequest &request) {
+  os << "[" << request.id << "] " << request.identifier << " #"
+     << request.sequence << " of subscription " << request.subscription << " ("
+     << request.seat_availability << " seat(s) avail.)";
+  return os;
+}
 
-[[nodiscard]] std::vector<std::byte>
-Marshal<dfis::SeatAvailabilityMonitoringRequest>::operator()(
-    const dfis::SeatAvailabilityMonitoringRequest &request) const {
-  std::vector<std::byte> data(sizeof(i32));
+std::ostream &operator<<(std::ostream &os,
+                         const SeatAvailabilitySnapshotRequest &request) {
+  os << "[" << request.id << "] " << request.identifier << " of subscription "
+     << request.subscription;
+  return os;
+}
 
-  Marshal<i32>{}(
-      static_cast<i32>(dfis::SeatAvailabilityMonitoringRequest::kMessageType),
-      std::span<std::byte, sizeof(i32)>{data.data(),
-                                        data.data() + sizeof(i32)});
+std::ostream &operator<<(std::ostream &os,
+                         const SeatAvailabilitySnapshotResponse &response) {
+  os << "[" << response.id << "] ";
+  if (response.status_code != 0) {
+    os << "Error: " << response.message;
+  } else {
+    os << response.identifier << " #" << response.sequence << " ("
+       << response.seat_availability << " seat(s) avail.)";
+  }
+  return os;
+}
 
-  auto id = Marshal<u64>{}(request.id);
-  data.insert(data.end(), id.begin(), id.end());
+std::ostream &operator<<(std::ostream &os,
+                         const MulticastMonitoringRequest &request) {
+  os << "[" << request.id << "] " << request.identifier << " via multicast ("
+     << request.monitor_interval_sec << "s)";
+  return os;
+}
 
-  auto identifier = Marshal<i32>{}(request.identifier);
-  data.insert(data.end(), identifier.begin(), identifier.end());
+std::ostream &operator<<(std::ostream &os,
+                         const MulticastMonitoringResponse &response) {
+  os << "[" << response.id << "] ";
+  if (response.status_code != 0) {
+    os << "Error: " << response.message;
+  } else {
+    os << "Monitoring " << response.identifier << " via " << response.group
+       << ":" << response.port << " until "
+       << FormatTimestamp(response.monitor_end);
+  }
+  return os;
+}
 
-  auto port = Marshal<u16>{}(request.port);
-  data.insert(data.end(), port.begin(), port.end());
+}  // namespace dfis
 
-  auto monitor_interval_sec = Marshal<i32>{}(request.monitor_interval_sec);
-  data.insert(data.end(), monitor_interval_sec.begin(),
-              monitor_interval_sec.end());
+namespace srpc {
 
-  return data;
+void Marshal<dfis::SeatAvailabilityMonitoringRequest>::operator()(
+    const dfis::SeatAvailabilityMonitoringRequest &request,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
 }
 
 [[nodiscard]] std::pair<i64,
                         std::optional<dfis::SeatAvailabilityMonitoringRequest>>
 Unmarshal<dfis::SeatAvailabilityMonitoringRequest>::operator()(
     const std::span<const std::byte> &data) const {
-  if (data.size() < sizeof(i32)) {
-    return {0, {}};
-  }
-
-  auto message_type = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data(), data.data() + sizeof(i32)});
-  if (dfis::MessageType{message_type} !=
-      dfis::SeatAvailabilityMonitoringRequest::kMessageType) {
-    return {0, {}};
-  }
-
-  i64 p = sizeof(i32);
-
-  if (p + sizeof(u64) > data.size()) {
-    return {0, {}};
-  }
-  auto id = Unmarshal<u64>{}(std::span<const std::byte, sizeof(u64)>{
-      data.data() + p, data.data() + p + sizeof(u64)});
-  p += sizeof(u64);
-
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto identifier = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  if (p + sizeof(u16) > data.size()) {
-    return {0, {}};
-  }
-  auto port = Unmarshal<u16>{}(std::span<const std::byte, sizeof(u16)>{
-      data.data() + p, data.data() + p + sizeof(u16)});
-  p += sizeof(u16);
-
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto monitor_interval_sec =
-      Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-          data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  return {p, dfis::SeatAvailabilityMonitoringRequest{
-                 .id = id,
-                 .identifier = identifier,
-                 .port = port,
-                 .monitor_interval_sec = monitor_interval_sec,
-             }};
+  return dfis::Decode<dfis::SeatAvailabilityMonitoringRequest>(data);
 }
 
-[[nodiscard]] std::vector<std::byte>
-Marshal<dfis::SeatAvailabilityMonitoringResponse>::operator()(
-    const dfis::SeatAvailabilityMonitoringResponse &response) const {
-  std::vector<std::byte> data(sizeof(i32));
-
-  Marshal<i32>{}(
-      static_cast<i32>(dfis::SeatAvailabilityMonitoringResponse::kMessageType),
-      std::span<std::byte, sizeof(i32)>{data.data(),
-                                        data.data() + sizeof(i32)});
-
-  auto id = Marshal<u64>{}(response.id);
-  data.insert(data.end(), id.begin(), id.end());
-
-  auto status_code = Marshal<i32>{}(response.status_code);
-  data.insert(data.end(), status_code.begin(), status_code.end());
-
-  auto message = Marshal<std::string>{}(response.message);
-  data.insert(data.end(), message.begin(), message.end());
-
-  auto identifier = Marshal<i32>{}(response.identifier);
-  data.insert(data.end(), identifier.begin(), identifier.end());
-
-  auto monitor_end = Marshal<i64>{}(response.monitor_end);
-  data.insert(data.end(), monitor_end.begin(), monitor_end.end());
-
-  return data;
+void Marshal<dfis::SeatAvailabilityMonitoringResponse>::operator()(
+    const dfis::SeatAvailabilityMonitoringResponse &response,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(response, writer);
 }
 
 [[nodiscard]] std::pair<i64,
                         std::optional<dfis::SeatAvailabilityMonitoringResponse>>
 Unmarshal<dfis::SeatAvailabilityMonitoringResponse>::operator()(
     const std::span<const std::byte> &data) const {
-  if (data.size() < sizeof(i32)) {
-    return {0, {}};
-  }
-
-  auto message_type = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data(), data.data() + sizeof(i32)});
-  if (dfis::MessageType{message_type} !=
-      dfis::SeatAvailabilityMonitoringResponse::kMessageType) {
-    return {0, {}};
-  }
-
-  i64 p = sizeof(i32);
-
-  if (p + sizeof(u64) > data.size()) {
-    return {0, {}};
-  }
-  auto id = Unmarshal<u64>{}(std::span<const std::byte, sizeof(u64)>{
-      data.data() + p, data.data() + p + sizeof(u64)});
-  p += sizeof(u64);
-
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto status_code = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  auto message_res = Unmarshal<std::string>{}(
-      std::span<const std::byte>{data.data() + p, data.data() + data.size()});
-  if (!message_res.second.has_value()) {
-    return {0, {}};
-  }
-  auto message = std::move(*message_res.second);
-  p += message_res.first;
-
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto identifier = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  if (p + sizeof(i64) > data.size()) {
-    return {0, {}};
-  }
-  auto monitor_end = Unmarshal<i64>{}(std::span<const std::byte, sizeof(i64)>{
-      data.data() + p, data.data() + p + sizeof(i64)});
-  p += sizeof(i64);
-
-  return {p, dfis::SeatAvailabilityMonitoringResponse{
-                 .id = id,
-                 .status_code = status_code,
-                 .message = message,
-                 .identifier = identifier,
-                 .monitor_end = monitor_end,
-             }};
+  return dfis::Decode<dfis::SeatAvailabilityMonitoringResponse>(data);
 }
 
-[[nodiscard]] std::vector<std::byte>
-Marshal<dfis::SeatAvailabilityCallbackRequest>::operator()(
-    const dfis::SeatAvailabilityCallbackRequest &request) const {
-  std::vector<std::byte> data(sizeof(i32));
+void Marshal<dfis::RouteMonitoringRequest>::operator()(
+    const dfis::RouteMonitoringRequest &request,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
+}
 
-  Marshal<i32>{}(
-      static_cast<i32>(dfis::SeatAvailabilityCallbackRequest::kMessageType),
-      std::span<std::byte, sizeof(i32)>{data.data(),
-                                        data.data() + sizeof(i32)});
+[[nodiscard]] std::pair<i64, std::optional<dfis::RouteMonitoringRequest>>
+Unmarshal<dfis::RouteMonitoringRequest>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::RouteMonitoringRequest>(data);
+}
 
-  auto id = Marshal<u64>{}(request.id);
-  data.insert(data.end(), id.begin(), id.end());
+[[nodiscard]] std::pair<i64, std::optional<dfis::RouteMonitoringRequestView>>
+Unmarshal<dfis::RouteMonitoringRequestView>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::RouteMonitoringRequestView>(data);
+}
 
-  auto identifier = Marshal<i32>{}(request.identifier);
-  data.insert(data.end(), identifier.begin(), identifier.end());
+void Marshal<dfis::RouteMonitoringResponse>::operator()(
+    const dfis::RouteMonitoringResponse &response,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(response, writer);
+}
 
-  auto seat_availability = Marshal<i32>{}(request.seat_availability);
-  data.insert(data.end(), seat_availability.begin(), seat_availability.end());
+[[nodiscard]] std::pair<i64, std::optional<dfis::RouteMonitoringResponse>>
+Unmarshal<dfis::RouteMonitoringResponse>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::RouteMonitoringResponse>(data);
+}
 
-  return data;
+void Marshal<dfis::SeatAvailabilityCallbackRequest>::operator()(
+    const dfis::SeatAvailabilityCallbackRequest &request,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
 }
 
 [[nodiscard]] std::pair<i64,
                         std::optional<dfis::SeatAvailabilityCallbackRequest>>
 Unmarshal<dfis::SeatAvailabilityCallbackRequest>::operator()(
     const std::span<const std::byte> &data) const {
-  if (data.size() < sizeof(i32)) {
-    return {0, {}};
-  }
-
-  auto message_type = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data(), data.data() + sizeof(i32)});
-  if (dfis::MessageType{message_type} !=
-      dfis::SeatAvailabilityCallbackRequest::kMessageType) {
-    return {0, {}};
-  }
-
-  i64 p = sizeof(i32);
-
-  if (p + sizeof(u64) > data.size()) {
-    return {0, {}};
-  }
-  auto id = Unmarshal<u64>{}(std::span<const std::byte, sizeof(u64)>{
-      data.data() + p, data.data() + p + sizeof(u64)});
-  p += sizeof(u64);
-
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto identifier = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto seat_availability =
-      Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-          data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  return {p, dfis::SeatAvailabilityCallbackRequest{
-                 .id = id,
-                 .identifier = identifier,
-                 .seat_availability = seat_availability,
-             }};
+  return dfis::Decode<dfis::SeatAvailabilityCallbackRequest>(data);
 }
 
-[[nodiscard]] std::vector<std::byte>
-Marshal<dfis::SeatAvailabilityCallbackResponse>::operator()(
-    const dfis::SeatAvailabilityCallbackResponse &response) const {
-  std::vector<std::byte> data(sizeof(i32));
-
-  Marshal<i32>{}(
-      static_cast<i32>(dfis::SeatAvailabilityCallbackResponse::kMessageType),
-      std::span<std::byte, sizeof(i32)>{data.data(),
-                                        data.data() + sizeof(i32)});
-
-  auto id = Marshal<u64>{}(response.id);
-  data.insert(data.end(), id.begin(), id.end());
+void Marshal<dfis::SeatAvailabilitySnapshotRequest>::operator()(
+    const dfis::SeatAvailabilitySnapshotRequest &request,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
+}
 
-  auto status_code = Marshal<i32>{}(response.status_code);
-  data.insert(data.end(), status_code.begin(), status_code.end());
+[[nodiscard]] std::pair<i64,
+                        std::optional<dfis::SeatAvailabilitySnapshotRequest>>
+Unmarshal<dfis::SeatAvailabilitySnapshotRequest>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::SeatAvailabilitySnapshotRequest>(data);
+}
 
-  return data;
+void Marshal<dfis::SeatAvailabilitySnapshotResponse>::operator()(
+    const dfis::SeatAvailabilitySnapshotResponse &response,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(response, writer);
 }
 
 [[nodiscard]] std::pair<i64,
-                        std::optional<dfis::SeatAvailabilityCallbackResponse>>
-Unmarshal<dfis::SeatAvailabilityCallbackResponse>::operator()(
+                        std::optional<dfis::SeatAvailabilitySnapshotResponse>>
+Unmarshal<dfis::SeatAvailabilitySnapshotResponse>::operator()(
     const std::span<const std::byte> &data) const {
-  if (data.size() < sizeof(i32)) {
-    return {0, {}};
-  }
+  return dfis::Decode<dfis::SeatAvailabilitySnapshotResponse>(data);
+}
 
-  auto message_type = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data(), data.data() + sizeof(i32)});
-  if (dfis::MessageType{message_type} !=
-      dfis::SeatAvailabilityCallbackResponse::kMessageType) {
-    return {0, {}};
-  }
+void Marshal<dfis::MulticastMonitoringRequest>::operator()(
+    const dfis::MulticastMonitoringRequest &request,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
+}
 
-  i64 p = sizeof(i32);
+[[nodiscard]] std::pair<i64, std::optional<dfis::MulticastMonitoringRequest>>
+Unmarshal<dfis::MulticastMonitoringRequest>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::MulticastMonitoringRequest>(data);
+}
 
-  if (p + sizeof(u64) > data.size()) {
-    return {0, {}};
-  }
-  auto id = Unmarshal<u64>{}(std::span<const std::byte, sizeof(u64)>{
-      data.data() + p, data.data() + p + sizeof(u64)});
-  p += sizeof(u64);
+void Marshal<dfis::MulticastMonitoringResponse>::operator()(
+    const dfis::MulticastMonitoringResponse &response,
+    dfis::ByteWriter &writer) const {
+  dfis::Encode(response, writer);
+}
 
-  if (p + sizeof(i32) > data.size()) {
-    return {0, {}};
-  }
-  auto status_code = Unmarshal<i32>{}(std::span<const std::byte, sizeof(i32)>{
-      data.data() + p, data.data() + p + sizeof(i32)});
-  p += sizeof(i32);
-
-  return {p, dfis::SeatAvailabilityCallbackResponse{
-                 .id = id,
-                 .status_code = status_code,
-             }};
+[[nodiscard]] std::pair<i64, std::optional<dfis::MulticastMonitoringResponse>>
+Unmarshal<dfis::MulticastMonitoringResponse>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::MulticastMonitoringResponse>(data);
 }
 
 }  // namespace srpc
@@ -6,16 +6,33 @@
 #include <ostream>
 #include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/codec.h"
 #include "messages/message_type.h"
+#include "messages/wire.h"
 
 namespace dfis {
 
+// When a monitor is to be notified of a seat availability change. All but
+// kEveryChange are edge-triggered on the condition availability < threshold.
+enum class SeatAvailabilityTrigger : srpc::i8 {
+  kEveryChange = 0,
+  kFallsBelow = 1,
+  kRisesTo = 2,
+  kCrosses = 3,
+};
+
+[[nodiscard]] bool IsValidSeatAvailabilityTrigger(srpc::i8 trigger);
+
+std::ostream &operator<<(std::ostream &os, SeatAvailabilityTrigger trigger);
+
 struct SeatAvailabilityMonitoringRequest {
   static constexpr MessageType kMessageType =
       MessageType::kSeatAvailabilityMonitoringRequest;
@@ -23,6 +40,21 @@ struct SeatAvailabilityMonitoringRequest {
   srpc::i32 identifier;
   srpc::u16 port;
   srpc::i32 monitor_interval_sec;
+  srpc::i32 coalesce_window_ms;
+  SeatAvailabilityTrigger trigger;
+  srpc::i32 threshold;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatAvailabilityMonitoringRequest::id,
+        &SeatAvailabilityMonitoringRequest::identifier,
+        &SeatAvailabilityMonitoringRequest::port,
+        &SeatAvailabilityMonitoringRequest::monitor_interval_sec,
+        &SeatAvailabilityMonitoringRequest::coalesce_window_ms,
+        &SeatAvailabilityMonitoringRequest::trigger,
+        &SeatAvailabilityMonitoringRequest::threshold,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
@@ -35,32 +67,244 @@ struct SeatAvailabilityMonitoringResponse {
   srpc::i32 status_code;
   std::string message;
   srpc::i32 identifier;
+  srpc::u64 subscription;
   srpc::i64 monitor_end;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatAvailabilityMonitoringResponse::id,
+        &SeatAvailabilityMonitoringResponse::status_code,
+        &SeatAvailabilityMonitoringResponse::message,
+        &SeatAvailabilityMonitoringResponse::identifier,
+        &SeatAvailabilityMonitoringResponse::subscription,
+        &SeatAvailabilityMonitoringResponse::monitor_end,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
                          const SeatAvailabilityMonitoringResponse &response);
 
+// Monitors every flight from source to destination departing within
+// [departure_from, departure_to]. A departure_to of 0 leaves the window
+// open-ended.
+struct RouteMonitoringRequest {
+  static constexpr MessageType kMessageType =
+      MessageType::kRouteMonitoringRequest;
+  srpc::u64 id;
+  std::string source;
+  std::string destination;
+  srpc::i64 departure_from;
+  srpc::i64 departure_to;
+  srpc::u16 port;
+  srpc::i32 monitor_interval_sec;
+  srpc::i32 coalesce_window_ms;
+  SeatAvailabilityTrigger trigger;
+  srpc::i32 threshold;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &RouteMonitoringRequest::id,
+        &RouteMonitoringRequest::source,
+        &RouteMonitoringRequest::destination,
+        &RouteMonitoringRequest::departure_from,
+        &RouteMonitoringRequest::departure_to,
+        &RouteMonitoringRequest::port,
+        &RouteMonitoringRequest::monitor_interval_sec,
+        &RouteMonitoringRequest::coalesce_window_ms,
+        &RouteMonitoringRequest::trigger,
+        &RouteMonitoringRequest::threshold,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const RouteMonitoringRequest &request);
+
+// A RouteMonitoringRequest decoded in place. It refers into the buffer it was
+// decoded from, and is only valid for as long as that buffer is.
+struct RouteMonitoringRequestView {
+  static constexpr MessageType kMessageType =
+      RouteMonitoringRequest::kMessageType;
+  srpc::u64 id;
+  std::string_view source;
+  std::string_view destination;
+  srpc::i64 departure_from;
+  srpc::i64 departure_to;
+  srpc::u16 port;
+  srpc::i32 monitor_interval_sec;
+  srpc::i32 coalesce_window_ms;
+  SeatAvailabilityTrigger trigger;
+  srpc::i32 threshold;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &RouteMonitoringRequestView::id,
+        &RouteMonitoringRequestView::source,
+        &RouteMonitoringRequestView::destination,
+        &RouteMonitoringRequestView::departure_from,
+        &RouteMonitoringRequestView::departure_to,
+        &RouteMonitoringRequestView::port,
+        &RouteMonitoringRequestView::monitor_interval_sec,
+        &RouteMonitoringRequestView::coalesce_window_ms,
+        &RouteMonitoringRequestView::trigger,
+        &RouteMonitoringRequestView::threshold,
+    };
+  }
+
+  [[nodiscard]] RouteMonitoringRequest ToRequest() const;
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const RouteMonitoringRequestView &request);
+
+struct RouteMonitoringResponse {
+  static constexpr MessageType kMessageType =
+      MessageType::kRouteMonitoringResponse;
+  srpc::u64 id;
+  srpc::i32 status_code;
+  std::string message;
+  // The flights currently matching the request.
+  std::vector<srpc::i32> flights;
+  srpc::u64 subscription;
+  srpc::i64 monitor_end;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &RouteMonitoringResponse::id,
+        &RouteMonitoringResponse::status_code,
+        &RouteMonitoringResponse::message,
+        &RouteMonitoringResponse::flights,
+        &RouteMonitoringResponse::subscription,
+        &RouteMonitoringResponse::monitor_end,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const RouteMonitoringResponse &response);
+
+// A one-way update. Updates to each flight of a subscription are numbered
+// consecutively from 1, so that the receiver can detect missed updates.
 struct SeatAvailabilityCallbackRequest {
   static constexpr MessageType kMessageType =
       MessageType::kSeatAvailabilityCallbackRequest;
   srpc::u64 id;
+  srpc::u64 subscription;
   srpc::i32 identifier;
+  srpc::u64 sequence;
   srpc::i32 seat_availability;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatAvailabilityCallbackRequest::id,
+        &SeatAvailabilityCallbackRequest::subscription,
+        &SeatAvailabilityCallbackRequest::identifier,
+        &SeatAvailabilityCallbackRequest::sequence,
+        &SeatAvailabilityCallbackRequest::seat_availability,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
                          const SeatAvailabilityCallbackRequest &request);
 
-struct SeatAvailabilityCallbackResponse {
+// Asks for the latest update sent to a subscription for one of its flights.
+struct SeatAvailabilitySnapshotRequest {
+  static constexpr MessageType kMessageType =
+      MessageType::kSeatAvailabilitySnapshotRequest;
+  srpc::u64 id;
+  srpc::u64 subscription;
+  srpc::i32 identifier;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatAvailabilitySnapshotRequest::id,
+        &SeatAvailabilitySnapshotRequest::subscription,
+        &SeatAvailabilitySnapshotRequest::identifier,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const SeatAvailabilitySnapshotRequest &request);
+
+// A sequence of 0 means no update has been sent yet, and carries the
+// availability at the time of subscription.
+struct SeatAvailabilitySnapshotResponse {
   static constexpr MessageType kMessageType =
-      MessageType::kSeatAvailabilityCallbackResponse;
+      MessageType::kSeatAvailabilitySnapshotResponse;
   srpc::u64 id;
   srpc::i32 status_code;
+  std::string message;
+  srpc::i32 identifier;
+  srpc::u64 sequence;
+  srpc::i32 seat_availability;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatAvailabilitySnapshotResponse::id,
+        &SeatAvailabilitySnapshotResponse::status_code,
+        &SeatAvailabilitySnapshotResponse::message,
+        &SeatAvailabilitySnapshotResponse::identifier,
+        &SeatAvailabilitySnapshotResponse::sequence,
+        &SeatAvailabilitySnapshotResponse::seat_availability,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
-                         const SeatAvailabilityCallbackResponse &response);
+                         const SeatAvailabilitySnapshotResponse &response);
+
+// Monitors a flight by joining the multicast group its updates are sent to,
+// instead of having them sent to a callback port.
+struct MulticastMonitoringRequest {
+  static constexpr MessageType kMessageType =
+      MessageType::kMulticastMonitoringRequest;
+  srpc::u64 id;
+  srpc::i32 identifier;
+  srpc::i32 monitor_interval_sec;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &MulticastMonitoringRequest::id,
+        &MulticastMonitoringRequest::identifier,
+        &MulticastMonitoringRequest::monitor_interval_sec,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const MulticastMonitoringRequest &request);
+
+// Updates are sent with a subscription of 0, and numbered per flight. The
+// group may carry updates to other flights as well.
+struct MulticastMonitoringResponse {
+  static constexpr MessageType kMessageType =
+      MessageType::kMulticastMonitoringResponse;
+  srpc::u64 id;
+  srpc::i32 status_code;
+  std::string message;
+  srpc::i32 identifier;
+  std::string group;
+  srpc::u16 port;
+  srpc::i64 monitor_end;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &MulticastMonitoringResponse::id,
+        &MulticastMonitoringResponse::status_code,
+        &MulticastMonitoringResponse::message,
+        &MulticastMonitoringResponse::identifier,
+        &MulticastMonitoringResponse::group,
+        &MulticastMonitoringResponse::port,
+        &MulticastMonitoringResponse::monitor_end,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const MulticastMonitoringResponse &response);
 
 }  // namespace dfis
 
@@ -69,7 +313,12 @@ namespace srpc {
 template <>
 struct Marshal<dfis::SeatAvailabilityMonitoringRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatAvailabilityMonitoringRequest &request) const;
+      const dfis::SeatAvailabilityMonitoringRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::SeatAvailabilityMonitoringRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -82,7 +331,12 @@ struct Unmarshal<dfis::SeatAvailabilityMonitoringRequest> {
 template <>
 struct Marshal<dfis::SeatAvailabilityMonitoringResponse> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatAvailabilityMonitoringResponse &response) const;
+      const dfis::SeatAvailabilityMonitoringResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::SeatAvailabilityMonitoringResponse &response,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -92,10 +346,55 @@ struct Unmarshal<dfis::SeatAvailabilityMonitoringResponse> {
   operator()(const std::span<const std::byte> &data) const;
 };
 
+template <>
+struct Marshal<dfis::RouteMonitoringRequest> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::RouteMonitoringRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::RouteMonitoringRequest &request,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::RouteMonitoringRequest> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::RouteMonitoringRequest>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Unmarshal<dfis::RouteMonitoringRequestView> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::RouteMonitoringRequestView>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Marshal<dfis::RouteMonitoringResponse> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::RouteMonitoringResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::RouteMonitoringResponse &response,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::RouteMonitoringResponse> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::RouteMonitoringResponse>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
 template <>
 struct Marshal<dfis::SeatAvailabilityCallbackRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatAvailabilityCallbackRequest &request) const;
+      const dfis::SeatAvailabilityCallbackRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::SeatAvailabilityCallbackRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -106,15 +405,72 @@ struct Unmarshal<dfis::SeatAvailabilityCallbackRequest> {
 };
 
 template <>
-struct Marshal<dfis::SeatAvailabilityCallbackResponse> {
+struct Marshal<dfis::SeatAvailabilitySnapshotRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatAvailabilityCallbackResponse &response) const;
+      const dfis::SeatAvailabilitySnapshotRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::SeatAvailabilitySnapshotRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
-struct Unmarshal<dfis::SeatAvailabilityCallbackResponse> {
+struct Unmarshal<dfis::SeatAvailabilitySnapshotRequest> {
   [[nodiscard]] std::pair<i64,
-                          std::optional<dfis::SeatAvailabilityCallbackResponse>>
+                          std::optional<dfis::SeatAvailabilitySnapshotRequest>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Marshal<dfis::SeatAvailabilitySnapshotResponse> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::SeatAvailabilitySnapshotResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::SeatAvailabilitySnapshotResponse &response,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::SeatAvailabilitySnapshotResponse> {
+  [[nodiscard]] std::pair<i64,
+                          std::optional<dfis::SeatAvailabilitySnapshotResponse>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Marshal<dfis::MulticastMonitoringRequest> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::MulticastMonitoringRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::MulticastMonitoringRequest &request,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::MulticastMonitoringRequest> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::MulticastMonitoringRequest>>
+  operator()(const std::span<const std::byte> &data) const;
+};
+
+template <>
+struct Marshal<dfis::MulticastMonitoringResponse> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::MulticastMonitoringResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::MulticastMonitoringResponse &response,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::MulticastMonitoringResponse> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::MulticastMonitoringResponse>>
   operator()(const std::span<const std::byte> &data) const;
 };
 
@@ -6,13 +6,16 @@
 #include <ostream>
 #include <span>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/codec.h"
 #include "messages/message_type.h"
+#include "messages/wire.h"
 
 namespace dfis {
 
@@ -22,6 +25,14 @@ struct SeatReservationRequest {
   srpc::u64 id;
   srpc::i32 identifier;
   srpc::i32 seats;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatReservationRequest::id,
+        &SeatReservationRequest::identifier,
+        &SeatReservationRequest::seats,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
@@ -35,6 +46,16 @@ struct SeatReservationResponse {
   std::string message;
   srpc::i32 identifier;
   srpc::i32 seats;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatReservationResponse::id,
+        &SeatReservationResponse::status_code,
+        &SeatReservationResponse::message,
+        &SeatReservationResponse::identifier,
+        &SeatReservationResponse::seats,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
@@ -47,6 +68,15 @@ struct SeatReservationCancellationRequest {
   srpc::u64 reservation_req_id;
   srpc::i32 identifier;
   srpc::i32 seats;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatReservationCancellationRequest::id,
+        &SeatReservationCancellationRequest::reservation_req_id,
+        &SeatReservationCancellationRequest::identifier,
+        &SeatReservationCancellationRequest::seats,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
@@ -60,6 +90,16 @@ struct SeatReservationCancellationResponse {
   std::string message;
   srpc::i32 identifier;
   srpc::i32 seats;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &SeatReservationCancellationResponse::id,
+        &SeatReservationCancellationResponse::status_code,
+        &SeatReservationCancellationResponse::message,
+        &SeatReservationCancellationResponse::identifier,
+        &SeatReservationCancellationResponse::seats,
+    };
+  }
 };
 
 std::ostream &operator<<(std::ostream &os,
@@ -72,7 +112,12 @@ namespace srpc {
 template <>
 struct Marshal<dfis::SeatReservationRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatReservationRequest &request) const;
+      const dfis::SeatReservationRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::SeatReservationRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -84,7 +129,12 @@ struct Unmarshal<dfis::SeatReservationRequest> {
 template <>
 struct Marshal<dfis::SeatReservationResponse> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatReservationResponse &response) const;
+      const dfis::SeatReservationResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::SeatReservationResponse &response,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -96,7 +146,12 @@ struct Unmarshal<dfis::SeatReservationResponse> {
 template <>
 struct Marshal<dfis::SeatReservationCancellationRequest> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatReservationCancellationRequest &request) const;
+      const dfis::SeatReservationCancellationRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::SeatReservationCancellationRequest &request,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -109,7 +164,12 @@ struct Unmarshal<dfis::SeatReservationCancellationRequest> {
 template <>
 struct Marshal<dfis::SeatReservationCancellationResponse> {
   [[nodiscard]] std::vector<std::byte> operator()(
-      const dfis::SeatReservationCancellationResponse &response) const;
+      const dfis::SeatReservationCancellationResponse &response) const {
+    return dfis::MarshalToVector(response);
+  }
+
+  void operator()(const dfis::SeatReservationCancellationResponse &response,
+                  dfis::ByteWriter &writer) const;
 };
 
 template <>
@@ -0,0 +1,38 @@
+#include "messages/timed_request.h"
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <utility>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+std::ostream &operator<<(std::ostream &os, const TimedRequest &request) {
+  os << "[" << request.id << "] Request of " << request.request.size()
+     << " byte(s), due in " << request.time_budget_ms << " ms";
+  return os;
+}
+
+}  // namespace dfis
+
+namespace srpc {
+
+void Marshal<dfis::TimedRequest>::operator()(const dfis::TimedRequest &request,
+                                             dfis::ByteWriter &writer) const {
+  dfis::Encode(request, writer);
+}
+
+[[nodiscard]] std::pair<i64, std::optional<dfis::TimedRequest>>
+Unmarshal<dfis::TimedRequest>::operator()(
+    const std::span<const std::byte> &data) const {
+  return dfis::Decode<dfis::TimedRequest>(data);
+}
+
+}  // namespace srpc
@@ -0,0 +1,67 @@
+#ifndef DFIS_MESSAGES_TIMED_REQUEST_H_
+#define DFIS_MESSAGES_TIMED_REQUEST_H_
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/message_type.h"
+#include "messages/wire.h"
+
+namespace dfis {
+
+// Carries a request the client waits for only time_budget_ms longer, counted
+// from when the server receives it. The budget is relative, so clocks need not
+// be synchronised; a request still queued when it runs out is dropped unserved,
+// as nobody would read the response.
+struct TimedRequest {
+  static constexpr MessageType kMessageType = MessageType::kTimedRequest;
+  // The same as the identifier of the request carried.
+  srpc::u64 id;
+  srpc::u32 time_budget_ms;
+  // A marshalled request. Refers to the datagram it was decoded from.
+  std::span<const std::byte> request;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &TimedRequest::id,
+        &TimedRequest::time_budget_ms,
+        &TimedRequest::request,
+    };
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const TimedRequest &request);
+
+}  // namespace dfis
+
+namespace srpc {
+
+template <>
+struct Marshal<dfis::TimedRequest> {
+  [[nodiscard]] std::vector<std::byte> operator()(
+      const dfis::TimedRequest &request) const {
+    return dfis::MarshalToVector(request);
+  }
+
+  void operator()(const dfis::TimedRequest &request,
+                  dfis::ByteWriter &writer) const;
+};
+
+template <>
+struct Unmarshal<dfis::TimedRequest> {
+  [[nodiscard]] std::pair<i64, std::optional<dfis::TimedRequest>> operator()(
+      const std::span<const std::byte> &data) const;
+};
+
+}  // namespace srpc
+
+#endif  // DFIS_MESSAGES_TIMED_REQUEST_H_
@@ -0,0 +1,65 @@
+#include "messages/wire.h"
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+namespace dfis {
+
+void ByteWriter::Write(std::string_view value) {
+  WriteBytes(std::as_bytes(std::span{value.data(), value.size()}));
+}
+
+void ByteWriter::WriteBytes(std::span<const std::byte> bytes) {
+  WriteLength(bytes.size());
+  auto *out = Reserve(bytes.size());
+  if (out != nullptr && !bytes.empty()) {
+    std::memcpy(out, bytes.data(), bytes.size());
+  }
+}
+
+std::byte *ByteWriter::Reserve(std::size_t size) {
+  if (vector_ != nullptr) {
+    auto offset = vector_->size();
+    vector_->resize(offset + size);
+    size_ += size;
+    return vector_->data() + offset;
+  }
+  if (!ok_ || span_.size() - size_ < size) {
+    ok_ = false;
+    return nullptr;
+  }
+  auto *out = span_.data() + size_;
+  size_ += size;
+  return out;
+}
+
+std::string_view ByteReader::ReadString() {
+  auto bytes = ReadBytes();
+  return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+}
+
+std::span<const std::byte> ByteReader::ReadBytes() {
+  auto length = Read<WireLength>();
+  const auto *in = Consume(length);
+  if (in == nullptr) {
+    return {};
+  }
+  return {in, length};
+}
+
+const std::byte *ByteReader::Consume(std::size_t size) {
+  if (!ok_ || data_.size() - position_ < size) {
+    ok_ = false;
+    return nullptr;
+  }
+  const auto *in = data_.data() + position_;
+  position_ += size;
+  return in;
+}
+
+}  // namespace dfis
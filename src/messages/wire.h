@@ -0,0 +1,126 @@
+#ifndef DFIS_MESSAGES_WIRE_H_
+#define DFIS_MESSAGES_WIRE_H_
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/byte_order.h"
+
+namespace dfis {
+
+// Scalars are encoded big-endian, as srpc encodes them. Strings and vectors are
+// framed by their length as a WireLength, followed by their elements.
+using WireLength = srpc::u32;
+
+// Encodes values into a caller-owned buffer, without intermediate vectors.
+//
+// A writer over a vector appends to it, growing it as needed; a vector that is
+// cleared and reused allocates nothing once it has grown to fit the largest
+// message. A writer over a span never allocates, and stops writing once the
+// span is full; check Ok() afterwards.
+class ByteWriter {
+ public:
+  explicit ByteWriter(std::vector<std::byte> &buffer) : vector_(&buffer) {}
+
+  explicit ByteWriter(std::span<std::byte> buffer) : span_(buffer) {}
+
+  template <BulkConvertible T>
+  void Write(T value) {
+    auto *out = Reserve(sizeof(T));
+    if (out != nullptr) {
+      StoreBigEndian(value, out);
+    }
+  }
+
+  void Write(std::string_view value);
+
+  // Writes raw bytes, framed by their length.
+  void WriteBytes(std::span<const std::byte> bytes);
+
+  template <typename T>
+  void Write(const std::vector<T> &values) {
+    WriteLength(values.size());
+    if constexpr (BulkConvertible<T>) {
+      auto *out = Reserve(values.size() * sizeof(T));
+      if (out != nullptr) {
+        EncodeBigEndian(std::span<const T>{values}, out);
+      }
+    } else {
+      for (const auto &value : values) {
+        srpc::Marshal<T>{}(value, *this);
+      }
+    }
+  }
+
+  void WriteLength(std::size_t length) {
+    Write(static_cast<WireLength>(length));
+  }
+
+  // Whether everything written so far has fit.
+  [[nodiscard]] bool Ok() const { return ok_; }
+
+  // The number of bytes written by this writer.
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+  // Claims the next size bytes for the caller to fill, or returns null if they
+  // do not fit.
+  [[nodiscard]] std::byte *Reserve(std::size_t size);
+
+ private:
+  std::vector<std::byte> *vector_ = nullptr;
+  std::span<std::byte> span_;
+  std::size_t size_ = 0;
+  bool ok_ = true;
+};
+
+// Decodes values in place from a received buffer. A read past the end yields
+// a zero value and clears Ok(), so that a message is validated once, after all
+// of its fields have been read.
+class ByteReader {
+ public:
+  explicit ByteReader(std::span<const std::byte> data) : data_(data) {}
+
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  [[nodiscard]] T Read() {
+    const auto *in = Consume(sizeof(T));
+    if (in == nullptr) {
+      return T{};
+    }
+    return srpc::Unmarshal<T>{}(
+        std::span<const std::byte, sizeof(T)>{in, in + sizeof(T)});
+  }
+
+  // Returns a view into the buffer, valid for as long as the buffer is.
+  [[nodiscard]] std::string_view ReadString();
+
+  // Reads raw bytes framed by their length, as a view like ReadString().
+  [[nodiscard]] std::span<const std::byte> ReadBytes();
+
+  [[nodiscard]] bool Ok() const { return ok_; }
+
+  // Marks the input as malformed.
+  void Fail() { ok_ = false; }
+
+  // The number of bytes read by this reader.
+  [[nodiscard]] std::size_t Position() const { return position_; }
+
+  // Skips over the next size bytes and returns where they start, or returns
+  // null if there are not that many left.
+  [[nodiscard]] const std::byte *Consume(std::size_t size);
+
+ private:
+  std::span<const std::byte> data_;
+  std::size_t position_ = 0;
+  bool ok_ = true;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_MESSAGES_WIRE_H_
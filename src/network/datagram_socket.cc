@@ -0,0 +1,322 @@
+#include "network/datagram_socket.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+namespace {
+
+constexpr std::size_t kMaxDatagramSize = 65535;
+
+void SetError(std::string *error, const std::string &what) {
+  if (error != nullptr) {
+    *error = what + ": " + std::system_category().message(errno);
+  }
+}
+
+bool ToSockaddr(int family, const srpc::SocketAddress &addr,
+                sockaddr_storage &storage, socklen_t &length) {
+  storage = {};
+  if (family == AF_INET) {
+    if (addr.protocol != srpc::kIPv4) {
+      errno = EAFNOSUPPORT;
+      return false;
+    }
+    auto *sin = reinterpret_cast<sockaddr_in *>(&storage);
+    sin->sin_family = AF_INET;
+    sin->sin_port = htons(addr.port);
+    if (inet_pton(AF_INET, addr.address.c_str(), &sin->sin_addr) != 1) {
+      errno = EINVAL;
+      return false;
+    }
+    length = sizeof(sockaddr_in);
+    return true;
+  }
+
+  auto *sin6 = reinterpret_cast<sockaddr_in6 *>(&storage);
+  sin6->sin6_family = AF_INET6;
+  sin6->sin6_port = htons(addr.port);
+  if (addr.protocol == srpc::kIPv4) {
+    // IPv4-mapped IPv6 address (::ffff:a.b.c.d).
+    in_addr v4{};
+    if (inet_pton(AF_INET, addr.address.c_str(), &v4) != 1) {
+      errno = EINVAL;
+      return false;
+    }
+    sin6->sin6_addr.s6_addr[10] = 0xff;
+    sin6->sin6_addr.s6_addr[11] = 0xff;
+    std::memcpy(&sin6->sin6_addr.s6_addr[12], &v4, sizeof(v4));
+  } else if (inet_pton(AF_INET6, addr.address.c_str(), &sin6->sin6_addr) !=
+             1) {
+    errno = EINVAL;
+    return false;
+  }
+  length = sizeof(sockaddr_in6);
+  return true;
+}
+
+srpc::SocketAddress FromSockaddr(const sockaddr_storage &storage) {
+  std::array<char, INET6_ADDRSTRLEN> buf{};
+  if (storage.ss_family == AF_INET) {
+    const auto *sin = reinterpret_cast<const sockaddr_in *>(&storage);
+    inet_ntop(AF_INET, &sin->sin_addr, buf.data(), buf.size());
+    return {
+        .protocol = srpc::kIPv4,
+        .address = buf.data(),
+        .port = ntohs(sin->sin_port),
+    };
+  }
+  const auto *sin6 = reinterpret_cast<const sockaddr_in6 *>(&storage);
+  if (IN6_IS_ADDR_V4MAPPED(&sin6->sin6_addr)) {
+    inet_ntop(AF_INET, &sin6->sin6_addr.s6_addr[12], buf.data(), buf.size());
+    return {
+        .protocol = srpc::kIPv4,
+        .address = buf.data(),
+        .port = ntohs(sin6->sin6_port),
+    };
+  }
+  inet_ntop(AF_INET6, &sin6->sin6_addr, buf.data(), buf.size());
+  return {
+      .protocol = srpc::kIPv6,
+      .address = buf.data(),
+      .port = ntohs(sin6->sin6_port),
+  };
+}
+
+// The kernel timestamp of a received message, or the current time if it has
+// none.
+std::chrono::system_clock::time_point ReceiveTime(msghdr &msg) {
+#if defined(SO_TIMESTAMPNS)
+  for (auto *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      timespec ts{};
+      std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+      return std::chrono::system_clock::time_point{
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::seconds{ts.tv_sec} +
+              std::chrono::nanoseconds{ts.tv_nsec})};
+    }
+  }
+#endif
+  return std::chrono::system_clock::now();
+}
+
+}  // namespace
+
+std::unique_ptr<DatagramSocket> DatagramSocket::New(srpc::u16 port,
+                                                    std::string *error) {
+  return Open(port, false, error);
+}
+
+std::unique_ptr<DatagramSocket> DatagramSocket::NewMulticastReceiver(
+    const std::string &group, srpc::u16 port, const std::string &interface_addr,
+    std::string *error) {
+  ip_mreq mreq{};
+  if (inet_pton(AF_INET, group.c_str(), &mreq.imr_multiaddr) != 1 ||
+      inet_pton(AF_INET, interface_addr.c_str(), &mreq.imr_interface) != 1) {
+    errno = EINVAL;
+    SetError(error, "Invalid multicast group " + group + " or interface " +
+                        interface_addr);
+    return nullptr;
+  }
+  auto socket = Open(port, true, error);
+  if (socket == nullptr) {
+    return nullptr;
+  }
+  // IPv4 options apply to IPv4 traffic of dual-stack sockets as well.
+  if (setsockopt(socket->fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq,
+                 sizeof(mreq)) != 0) {
+    SetError(error, "Unable to join multicast group " + group);
+    return nullptr;
+  }
+  return socket;
+}
+
+std::unique_ptr<DatagramSocket> DatagramSocket::Open(srpc::u16 port,
+                                                     bool reuse_address,
+                                                     std::string *error) {
+  int family = AF_INET6;
+  int fd = socket(AF_INET6, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd >= 0) {
+    int v6only = 0;
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &v6only, sizeof(v6only));
+  } else {
+    family = AF_INET;
+    fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  }
+  if (fd < 0) {
+    SetError(error, "Unable to create socket");
+    return nullptr;
+  }
+  if (reuse_address) {
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  }
+#if defined(SO_TIMESTAMPNS)
+  int timestamp = 1;
+  setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &timestamp, sizeof(timestamp));
+#endif
+
+  sockaddr_storage storage{};
+  socklen_t length = 0;
+  if (family == AF_INET6) {
+    auto *sin6 = reinterpret_cast<sockaddr_in6 *>(&storage);
+    sin6->sin6_family = AF_INET6;
+    sin6->sin6_addr = in6addr_any;
+    sin6->sin6_port = htons(port);
+    length = sizeof(sockaddr_in6);
+  } else {
+    auto *sin = reinterpret_cast<sockaddr_in *>(&storage);
+    sin->sin_family = AF_INET;
+    sin->sin_addr.s_addr = htonl(INADDR_ANY);
+    sin->sin_port = htons(port);
+    length = sizeof(sockaddr_in);
+  }
+  if (bind(fd, reinterpret_cast<sockaddr *>(&storage), length) != 0) {
+    SetError(error, "Unable to bind socket");
+    close(fd);
+    return nullptr;
+  }
+
+  length = sizeof(storage);
+  if (getsockname(fd, reinterpret_cast<sockaddr *>(&storage), &length) != 0) {
+    SetError(error, "Unable to get socket name");
+    close(fd);
+    return nullptr;
+  }
+
+  return std::unique_ptr<DatagramSocket>{
+      new DatagramSocket{fd, family, FromSockaddr(storage).port}};
+}
+
+std::optional<srpc::SocketAddress> DatagramSocket::Resolve(
+    const std::string &host, srpc::u16 port, std::string *error) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  addrinfo *result = nullptr;
+  int status = getaddrinfo(host.c_str(), nullptr, &hints, &result);
+  if (status != 0) {
+    if (error != nullptr) {
+      *error = std::string{"Unable to resolve "} + host + ": " +
+               gai_strerror(status);
+    }
+    return {};
+  }
+  sockaddr_storage storage{};
+  std::memcpy(&storage, result->ai_addr, result->ai_addrlen);
+  freeaddrinfo(result);
+  auto addr = FromSockaddr(storage);
+  addr.port = port;
+  return addr;
+}
+
+DatagramSocket::DatagramSocket(int fd, int family, srpc::u16 port)
+    : fd_(fd), family_(family), port_(port), buffer_(kMaxDatagramSize) {}
+
+DatagramSocket::~DatagramSocket() { close(fd_); }
+
+bool DatagramSocket::SetMulticastInterface(const std::string &interface_addr,
+                                           std::string *error) {
+  in_addr interface{};
+  if (inet_pton(AF_INET, interface_addr.c_str(), &interface) != 1) {
+    errno = EINVAL;
+    SetError(error, "Invalid interface " + interface_addr);
+    return false;
+  }
+  unsigned char ttl = 1;
+  unsigned char loop = 1;
+  if (setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &interface,
+                 sizeof(interface)) != 0 ||
+      setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+      setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) !=
+          0) {
+    SetError(error, "Unable to set multicast options");
+    return false;
+  }
+  return true;
+}
+
+bool DatagramSocket::SendTo(const srpc::SocketAddress &to_addr,
+                            std::span<const std::byte> data,
+                            std::string *error) {
+  sockaddr_storage storage{};
+  socklen_t length = 0;
+  if (!ToSockaddr(family_, to_addr, storage, length)) {
+    SetError(error, "Invalid address " + to_addr.address);
+    return false;
+  }
+  auto sent = sendto(fd_, data.data(), data.size(), 0,
+                     reinterpret_cast<sockaddr *>(&storage), length);
+  if (sent < 0) {
+    SetError(error, "Unable to send datagram");
+    return false;
+  }
+  return true;
+}
+
+std::optional<Datagram> DatagramSocket::ReceiveFrom(
+    std::chrono::milliseconds timeout, std::string *error) {
+  pollfd pfd{
+      .fd = fd_,
+      .events = POLLIN,
+      .revents = 0,
+  };
+  int ready = poll(&pfd, 1, static_cast<int>(timeout.count()));
+  if (ready < 0) {
+    SetError(error, "Unable to poll socket");
+    return {};
+  }
+  if (ready == 0) {
+    return {};
+  }
+
+  sockaddr_storage storage{};
+  iovec iov{
+      .iov_base = buffer_.data(),
+      .iov_len = buffer_.size(),
+  };
+  alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(timespec))> control{};
+  msghdr msg{};
+  msg.msg_name = &storage;
+  msg.msg_namelen = sizeof(storage);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.data();
+  msg.msg_controllen = control.size();
+  auto received = recvmsg(fd_, &msg, 0);
+  if (received < 0) {
+    SetError(error, "Unable to receive datagram");
+    return {};
+  }
+  return Datagram{
+      .from_addr = FromSockaddr(storage),
+      .data = {buffer_.begin(), buffer_.begin() + received},
+      .received_at = ReceiveTime(msg),
+  };
+}
+
+}  // namespace dfis
@@ -0,0 +1,84 @@
+#ifndef DFIS_NETWORK_DATAGRAM_SOCKET_H_
+#define DFIS_NETWORK_DATAGRAM_SOCKET_H_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+struct Datagram {
+  srpc::SocketAddress from_addr;
+  std::vector<std::byte> data;
+  // When the datagram arrived at the host, as stamped by the kernel where it
+  // can, so that time spent queued in the socket buffer is included.
+  std::chrono::system_clock::time_point received_at;
+};
+
+// A long-lived UDP socket that can talk to any number of peers. Unlike
+// srpc::DatagramClient, it is not bound to a single destination, so one socket
+// can be shared by all outgoing messages of a process.
+//
+// The socket is dual-stack where IPv6 is available. Peer addresses must be
+// numeric; use Resolve() to look up host names once beforehand.
+class DatagramSocket {
+ public:
+  // Binds to the given port, or to an ephemeral one if the port is 0.
+  [[nodiscard]] static std::unique_ptr<DatagramSocket> New(
+      srpc::u16 port = 0, std::string *error = nullptr);
+
+  // Binds to the given port, allowing other sockets to share it, and joins
+  // the IPv4 multicast group on the interface with the given address (0.0.0.0
+  // lets the system choose).
+  [[nodiscard]] static std::unique_ptr<DatagramSocket> NewMulticastReceiver(
+      const std::string &group, srpc::u16 port,
+      const std::string &interface_addr, std::string *error = nullptr);
+
+  [[nodiscard]] static std::optional<srpc::SocketAddress> Resolve(
+      const std::string &host, srpc::u16 port, std::string *error = nullptr);
+
+  DatagramSocket(const DatagramSocket &) = delete;
+  DatagramSocket &operator=(const DatagramSocket &) = delete;
+  ~DatagramSocket();
+
+  [[nodiscard]] int Fd() const { return fd_; }
+
+  [[nodiscard]] srpc::u16 Port() const { return port_; }
+
+  // Sends IPv4 multicast through the interface with the given address, to the
+  // local network only, and loops it back to receivers on this host.
+  bool SetMulticastInterface(const std::string &interface_addr,
+                             std::string *error = nullptr);
+
+  bool SendTo(const srpc::SocketAddress &to_addr,
+              std::span<const std::byte> data, std::string *error = nullptr);
+
+  // Waits up to the given timeout for a datagram; a negative timeout waits
+  // indefinitely. Returns nothing on timeout, or on error if error is set.
+  // Only one thread may receive from a socket at a time.
+  [[nodiscard]] std::optional<Datagram> ReceiveFrom(
+      std::chrono::milliseconds timeout, std::string *error = nullptr);
+
+ private:
+  static std::unique_ptr<DatagramSocket> Open(srpc::u16 port,
+                                              bool reuse_address,
+                                              std::string *error);
+
+  DatagramSocket(int fd, int family, srpc::u16 port);
+
+  int fd_;
+  int family_;
+  srpc::u16 port_;
+  std::vector<std::byte> buffer_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_NETWORK_DATAGRAM_SOCKET_H_
@@ -0,0 +1,221 @@
+#include "network/event_loop.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace dfis {
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+
+void SetError(std::string *error, const std::string &what) {
+  if (error != nullptr) {
+    *error = what + ": " + std::system_category().message(errno);
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<EventLoop> EventLoop::New(std::string *error) {
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    SetError(error, "Unable to create epoll instance");
+    return nullptr;
+  }
+  int wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wake_fd < 0) {
+    SetError(error, "Unable to create eventfd");
+    close(epoll_fd);
+    return nullptr;
+  }
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = wake_fd;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event) < 0) {
+    SetError(error, "Unable to watch eventfd");
+    close(wake_fd);
+    close(epoll_fd);
+    return nullptr;
+  }
+  return std::unique_ptr<EventLoop>{new EventLoop{epoll_fd, wake_fd}};
+}
+
+EventLoop::EventLoop(int epoll_fd, int wake_fd)
+    : epoll_fd_(epoll_fd), wake_fd_(wake_fd) {}
+
+EventLoop::~EventLoop() {
+  close(wake_fd_);
+  close(epoll_fd_);
+}
+
+void EventLoop::Post(std::function<void()> fn) {
+  {
+    std::lock_guard lock{mutex_};
+    queue_.push_back(std::move(fn));
+  }
+  Wake();
+}
+
+EventLoop::TimerId EventLoop::RunAfter(Clock::duration delay,
+                                       std::function<void()> fn) {
+  auto deadline = Clock::now() + delay;
+  TimerId id;
+  bool earliest;
+  {
+    std::lock_guard lock{mutex_};
+    id = next_timer_id_++;
+    auto it = timers_.emplace(std::pair{deadline, id}, std::move(fn)).first;
+    timer_deadlines_.emplace(id, deadline);
+    earliest = it == timers_.begin();
+  }
+  // Only a new earliest timer shortens the wait.
+  if (earliest) {
+    Wake();
+  }
+  return id;
+}
+
+bool EventLoop::Cancel(TimerId id) {
+  std::lock_guard lock{mutex_};
+  auto it = timer_deadlines_.find(id);
+  if (it == timer_deadlines_.end()) {
+    return false;
+  }
+  timers_.erase(std::pair{it->second, id});
+  timer_deadlines_.erase(it);
+  return true;
+}
+
+bool EventLoop::Watch(int fd, std::function<void()> on_readable,
+                      std::string *error) {
+  std::lock_guard lock{mutex_};
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+    SetError(error, "Unable to watch file descriptor");
+    return false;
+  }
+  watches_[fd] =
+      std::make_shared<std::function<void()>>(std::move(on_readable));
+  return true;
+}
+
+void EventLoop::Unwatch(int fd) {
+  std::lock_guard lock{mutex_};
+  if (watches_.erase(fd) > 0) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  }
+}
+
+void EventLoop::Run() {
+  std::array<epoll_event, kMaxEvents> events{};
+  for (;;) {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopping_ && queue_.empty()) {
+        stopping_ = false;
+        return;
+      }
+    }
+    int ready = epoll_wait(epoll_fd_, events.data(), kMaxEvents, WaitTimeout());
+    for (int i = 0; i < ready; ++i) {
+      if (events[i].data.fd == wake_fd_) {
+        std::uint64_t count;
+        // Resets the eventfd; it is non-blocking, so this cannot hang.
+        [[maybe_unused]] auto n = read(wake_fd_, &count, sizeof(count));
+      } else {
+        Dispatch(events[i].data.fd);
+      }
+    }
+    RunDueTimers();
+    RunPosted();
+  }
+}
+
+void EventLoop::Stop() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  Wake();
+}
+
+void EventLoop::Wake() {
+  std::uint64_t one = 1;
+  [[maybe_unused]] auto n = write(wake_fd_, &one, sizeof(one));
+}
+
+int EventLoop::WaitTimeout() {
+  std::lock_guard lock{mutex_};
+  if (!queue_.empty() || stopping_) {
+    return 0;
+  }
+  if (timers_.empty()) {
+    return -1;
+  }
+  // Rounded up, so that the loop does not wake just before the deadline.
+  auto timeout = std::chrono::ceil<std::chrono::milliseconds>(
+      timers_.begin()->first.first - Clock::now());
+  return static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(
+      timeout.count(), 0, INT_MAX));
+}
+
+void EventLoop::Dispatch(int fd) {
+  std::shared_ptr<std::function<void()>> on_readable;
+  {
+    std::lock_guard lock{mutex_};
+    auto it = watches_.find(fd);
+    if (it == watches_.end()) {
+      return;
+    }
+    on_readable = it->second;
+  }
+  (*on_readable)();
+}
+
+void EventLoop::RunDueTimers() {
+  std::vector<std::function<void()>> due;
+  {
+    std::lock_guard lock{mutex_};
+    auto now = Clock::now();
+    while (!timers_.empty() && timers_.begin()->first.first <= now) {
+      auto node = timers_.extract(timers_.begin());
+      timer_deadlines_.erase(node.key().second);
+      due.push_back(std::move(node.mapped()));
+    }
+  }
+  for (auto &fn : due) {
+    fn();
+  }
+}
+
+void EventLoop::RunPosted() {
+  std::deque<std::function<void()>> posted;
+  {
+    std::lock_guard lock{mutex_};
+    posted.swap(queue_);
+  }
+  for (auto &fn : posted) {
+    fn();
+  }
+}
+
+}  // namespace dfis
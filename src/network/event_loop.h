@@ -0,0 +1,120 @@
+#ifndef DFIS_NETWORK_EVENT_LOOP_H_
+#define DFIS_NETWORK_EVENT_LOOP_H_
+
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+// A reactor that waits, with epoll, on any number of file descriptors and
+// timers at once, on the thread that calls Run(). Handlers and posted work run
+// there one at a time, and coroutines awaiting I/O are resumed there, so that
+// many of them can wait at once without holding a thread each.
+//
+// Posting, timers and watching are safe from any thread; a wakeup eventfd
+// interrupts the wait when they change.
+class EventLoop {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using TimerId = srpc::u64;
+
+  [[nodiscard]] static std::unique_ptr<EventLoop> New(
+      std::string *error = nullptr);
+
+  EventLoop(const EventLoop &) = delete;
+  EventLoop &operator=(const EventLoop &) = delete;
+  ~EventLoop();
+
+  // Runs fn on the loop, after the work posted before it.
+  void Post(std::function<void()> fn);
+
+  void Post(std::coroutine_handle<> handle) {
+    Post([handle] { handle.resume(); });
+  }
+
+  // Runs fn on the loop once the delay has passed.
+  TimerId RunAfter(Clock::duration delay, std::function<void()> fn);
+
+  // Returns whether the timer was cancelled before it ran.
+  bool Cancel(TimerId id);
+
+  // Calls on_readable on the loop whenever fd has data to read, until
+  // Unwatch(). The fd must stay open while it is watched.
+  bool Watch(int fd, std::function<void()> on_readable,
+             std::string *error = nullptr);
+
+  void Unwatch(int fd);
+
+  // Runs until Stop() is called.
+  void Run();
+
+  // Makes Run() return once the work already posted is done. Timers and
+  // watches are kept for the next Run().
+  void Stop();
+
+  // Returns an awaitable that moves the awaiting coroutine onto the loop.
+  [[nodiscard]] auto Schedule() {
+    struct Awaiter {
+      EventLoop &loop;
+
+      [[nodiscard]] bool await_ready() const { return false; }
+      void await_suspend(std::coroutine_handle<> handle) { loop.Post(handle); }
+      void await_resume() const {}
+    };
+    return Awaiter{*this};
+  }
+
+  // Returns an awaitable that resumes the awaiting coroutine on the loop once
+  // the delay has passed.
+  [[nodiscard]] auto Sleep(Clock::duration delay) {
+    struct Awaiter {
+      EventLoop &loop;
+      Clock::duration delay;
+
+      [[nodiscard]] bool await_ready() const { return false; }
+      void await_suspend(std::coroutine_handle<> handle) {
+        loop.RunAfter(delay, [handle] { handle.resume(); });
+      }
+      void await_resume() const {}
+    };
+    return Awaiter{*this, delay};
+  }
+
+ private:
+  EventLoop(int epoll_fd, int wake_fd);
+
+  // Interrupts the wait of the loop.
+  void Wake();
+  // How long the loop may wait for I/O, in milliseconds, or -1 for ever.
+  int WaitTimeout();
+  void Dispatch(int fd);
+  void RunDueTimers();
+  void RunPosted();
+
+  int epoll_fd_;
+  int wake_fd_;
+  std::mutex mutex_;
+  std::deque<std::function<void()>> queue_;
+  // The pending timers, earliest first.
+  std::map<std::pair<Clock::time_point, TimerId>, std::function<void()>>
+      timers_;
+  std::unordered_map<TimerId, Clock::time_point> timer_deadlines_;
+  TimerId next_timer_id_ = 0;
+  // Shared so that a handler may unwatch its own fd while it runs.
+  std::unordered_map<int, std::shared_ptr<std::function<void()>>> watches_;
+  bool stopping_ = false;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_NETWORK_EVENT_LOOP_H_
@@ -0,0 +1,115 @@
+#include "network/fragmentation.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/fragment.h"
+
+namespace dfis {
+
+std::optional<std::vector<std::vector<std::byte>>> SplitIntoFragments(
+    srpc::u64 request_id, srpc::u64 message_id,
+    std::span<const std::byte> message, std::size_t max_payload) {
+  auto count = std::max<std::size_t>(
+      (message.size() + max_payload - 1) / max_payload, 1);
+  if (count > kMaxFragmentCount) {
+    return {};
+  }
+  std::vector<std::vector<std::byte>> fragments;
+  fragments.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto offset = i * max_payload;
+    fragments.push_back(srpc::Marshal<Fragment>{}(Fragment{
+        .request_id = request_id,
+        .message_id = message_id,
+        .index = static_cast<srpc::u16>(i),
+        .count = static_cast<srpc::u16>(count),
+        .payload = message.subspan(
+            offset, std::min(max_payload, message.size() - offset)),
+    }));
+  }
+  return fragments;
+}
+
+std::optional<std::vector<std::byte>> FragmentReassembler::Add(
+    const Fragment &fragment) {
+  if (fragment.request_id != request_id_ || fragment.count == 0 ||
+      fragment.count > kMaxFragmentCount || fragment.index >= fragment.count) {
+    return {};
+  }
+  if (!Started()) {
+    message_id_ = fragment.message_id;
+    pieces_.resize(fragment.count);
+    received_.resize(fragment.count);
+  } else if (fragment.message_id != message_id_ ||
+             fragment.count != pieces_.size() ||
+             received_count_ == pieces_.size()) {
+    return {};
+  }
+  if (received_[fragment.index]) {
+    return {};
+  }
+  pieces_[fragment.index].assign(fragment.payload.begin(),
+                                 fragment.payload.end());
+  received_[fragment.index] = true;
+  if (++received_count_ < pieces_.size()) {
+    return {};
+  }
+
+  std::size_t size = 0;
+  for (const auto &piece : pieces_) {
+    size += piece.size();
+  }
+  std::vector<std::byte> message;
+  message.reserve(size);
+  for (auto &piece : pieces_) {
+    message.insert(message.end(), piece.begin(), piece.end());
+    piece = {};
+  }
+  return message;
+}
+
+std::vector<srpc::u16> FragmentReassembler::Missing() const {
+  std::vector<srpc::u16> missing;
+  for (std::size_t i = 0; i < received_.size(); ++i) {
+    if (!received_[i]) {
+      missing.push_back(static_cast<srpc::u16>(i));
+    }
+  }
+  return missing;
+}
+
+void SentFragments::Add(srpc::u64 message_id,
+                        std::vector<std::vector<std::byte>> fragments) {
+  if (auto it = messages_.find(message_id); it != messages_.end()) {
+    it->second = std::move(fragments);
+    return;
+  }
+  if (capacity_ == 0) {
+    return;
+  }
+  if (messages_.size() == capacity_) {
+    messages_.erase(order_.front());
+    order_.pop_front();
+  }
+  messages_.emplace(message_id, std::move(fragments));
+  order_.push_back(message_id);
+}
+
+const std::vector<std::byte> *SentFragments::Find(srpc::u64 message_id,
+                                                  srpc::u16 index) const {
+  auto it = messages_.find(message_id);
+  if (it == messages_.end() || index >= it->second.size()) {
+    return nullptr;
+  }
+  return &it->second[index];
+}
+
+}  // namespace dfis
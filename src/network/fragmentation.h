@@ -0,0 +1,85 @@
+#ifndef DFIS_NETWORK_FRAGMENTATION_H_
+#define DFIS_NETWORK_FRAGMENTATION_H_
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <srpc/types/integers.h>
+
+#include "messages/fragment.h"
+
+namespace dfis {
+
+// Messages larger than this are split into fragments. Together with its header
+// a fragment then fits the minimum IPv6 MTU, and is never fragmented at the IP
+// layer, where losing one packet loses the whole datagram.
+inline constexpr std::size_t kMaxFragmentPayload = 1200;
+
+// Bounds the memory a partially received message may take.
+inline constexpr srpc::u16 kMaxFragmentCount = 4096;
+
+// Splits a response into marshalled Fragment datagrams, or returns nothing if
+// it needs more than kMaxFragmentCount of them.
+[[nodiscard]] std::optional<std::vector<std::vector<std::byte>>>
+SplitIntoFragments(srpc::u64 request_id, srpc::u64 message_id,
+                   std::span<const std::byte> message,
+                   std::size_t max_payload = kMaxFragmentPayload);
+
+// Reassembles the response to one request from its fragments, which may arrive
+// in any order and more than once. Fragments of other requests, and of any
+// response other than the first one seen, are ignored.
+class FragmentReassembler {
+ public:
+  explicit FragmentReassembler(srpc::u64 request_id)
+      : request_id_(request_id) {}
+
+  // Returns the whole response once the last missing fragment arrives.
+  [[nodiscard]] std::optional<std::vector<std::byte>> Add(
+      const Fragment &fragment);
+
+  // Whether any fragment has been accepted.
+  [[nodiscard]] bool Started() const { return !pieces_.empty(); }
+
+  [[nodiscard]] srpc::u64 MessageId() const { return message_id_; }
+
+  // The indices of the fragments yet to arrive.
+  [[nodiscard]] std::vector<srpc::u16> Missing() const;
+
+ private:
+  srpc::u64 request_id_;
+  srpc::u64 message_id_ = 0;
+  std::vector<std::vector<std::byte>> pieces_;
+  std::vector<bool> received_;
+  std::size_t received_count_ = 0;
+};
+
+// The fragments of the most recently split responses, kept so that those lost
+// can be sent again on their own. Not thread-safe.
+class SentFragments {
+ public:
+  // Keeps the fragments of up to capacity responses.
+  explicit SentFragments(std::size_t capacity) : capacity_(capacity) {}
+
+  void Add(srpc::u64 message_id, std::vector<std::vector<std::byte>> fragments);
+
+  // Returns the marshalled fragment, or null if it is no longer kept.
+  [[nodiscard]] const std::vector<std::byte> *Find(srpc::u64 message_id,
+                                                   srpc::u16 index) const;
+
+  [[nodiscard]] std::size_t Size() const { return messages_.size(); }
+
+ private:
+  std::size_t capacity_;
+  std::unordered_map<srpc::u64, std::vector<std::vector<std::byte>>>
+      messages_;
+  // Message identifiers, oldest first.
+  std::deque<srpc::u64> order_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_NETWORK_FRAGMENTATION_H_
@@ -0,0 +1,58 @@
+#include "network/retransmission.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace dfis {
+
+namespace {
+
+// The clock granularity term of RFC 6298, which keeps the timeout from
+// collapsing onto the smoothed RTT when the variation is tiny.
+constexpr RttEstimator::Duration kGranularity{1000};
+
+}  // namespace
+
+RttEstimator::RttEstimator(Duration initial, Duration min, Duration max)
+    : min_(min),
+      max_(std::max(min, max)),
+      rto_(std::clamp(initial, min_, max_)) {}
+
+void RttEstimator::Sample(Duration rtt) {
+  rtt = std::max(rtt, Duration{0});
+  if (!srtt_.has_value()) {
+    srtt_ = rtt;
+    rttvar_ = rtt / 2;
+  } else {
+    auto error = *srtt_ > rtt ? *srtt_ - rtt : rtt - *srtt_;
+    rttvar_ = (3 * rttvar_ + error) / 4;
+    srtt_ = (7 * *srtt_ + rtt) / 8;
+  }
+  rto_ = std::clamp(*srtt_ + std::max(kGranularity, 4 * rttvar_), min_, max_);
+}
+
+void RttEstimator::OnTimeout(Duration expired) {
+  rto_ = std::max(rto_, std::min(2 * expired, max_));
+}
+
+RttEstimator::Duration RttEstimator::Timeout(int attempt) const {
+  auto timeout = rto_;
+  for (int i = 0; i < attempt && timeout < max_; ++i) {
+    timeout *= 2;
+  }
+  return std::min(timeout, max_);
+}
+
+bool RetryBudget::TryRetry() {
+  if (tokens_ <= max_tokens_ / 2) {
+    return false;
+  }
+  tokens_ -= 1;
+  return true;
+}
+
+void RetryBudget::OnSuccess() {
+  tokens_ = std::min(tokens_ + ratio_, max_tokens_);
+}
+
+}  // namespace dfis
@@ -0,0 +1,73 @@
+#ifndef DFIS_NETWORK_RETRANSMISSION_H_
+#define DFIS_NETWORK_RETRANSMISSION_H_
+
+#include <chrono>
+#include <optional>
+
+#include <srpc/types/floats.h>
+
+namespace dfis {
+
+// Estimates the round-trip time to one destination, and from it the
+// retransmission timeout, as TCP does (Jacobson and Karels; RFC 6298). Samples
+// must only be taken from requests that were not retransmitted, as a response
+// cannot be matched to the copy it answers (Karn's algorithm). Not
+// thread-safe.
+class RttEstimator {
+ public:
+  using Duration = std::chrono::microseconds;
+
+  // The timeout is initial until the first sample, and always kept within
+  // [min, max].
+  RttEstimator(Duration initial, Duration min, Duration max);
+
+  void Sample(Duration rtt);
+
+  // Backs the timeout off after one that expired unanswered, and keeps it
+  // until the next sample (RFC 6298, 5.5), so that a rise in the round-trip
+  // time beyond the timeout, after which no sample can be taken, does not
+  // leave the timeout too short for good. Requests that time out together,
+  // having waited the same timeout, back it off only once.
+  void OnTimeout(Duration expired);
+
+  // The timeout for the given retransmission of a request, 0 being its first
+  // transmission, if none times out meanwhile. It doubles with each one.
+  [[nodiscard]] Duration Timeout(int attempt = 0) const;
+
+  [[nodiscard]] std::optional<Duration> SmoothedRtt() const { return srtt_; }
+
+ private:
+  Duration min_;
+  Duration max_;
+  Duration rto_;
+  std::optional<Duration> srtt_;
+  Duration rttvar_{0};
+};
+
+// Limits retransmissions to a fraction of the requests that succeed, so that a
+// server too overloaded to answer is not sent more and more copies of the
+// requests it has not answered (the retry throttling of gRPC). Each response
+// earns ratio tokens, up to max_tokens, and each retransmission spends one;
+// retransmissions are only allowed while more than half the tokens are left.
+// Not thread-safe.
+class RetryBudget {
+ public:
+  RetryBudget(srpc::f64 max_tokens, srpc::f64 ratio)
+      : max_tokens_(max_tokens), ratio_(ratio), tokens_(max_tokens) {}
+
+  // Spends a token if a retransmission is allowed.
+  [[nodiscard]] bool TryRetry();
+
+  void OnSuccess();
+
+  [[nodiscard]] srpc::f64 Tokens() const { return tokens_; }
+
+ private:
+  srpc::f64 max_tokens_;
+  srpc::f64 ratio_;
+  srpc::f64 tokens_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_NETWORK_RETRANSMISSION_H_
@@ -0,0 +1,89 @@
+#include "server/callback_dispatcher.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <utility>
+
+#include <srpc/network/tcp_ip.h>
+
+#include "messages/seat_availability.h"
+
+namespace dfis {
+
+std::ostream &operator<<(std::ostream &os,
+                         const CallbackDispatcherMetrics &metrics) {
+  os << metrics.dispatched << " dispatched, " << metrics.dropped
+     << " dropped, " << metrics.completed << " completed, " << metrics.queued
+     << " queued (max " << metrics.max_queued << ")";
+  return os;
+}
+
+CallbackDispatcher::CallbackDispatcher(std::size_t workers,
+                                       std::size_t capacity, Handler handler)
+    : capacity_(capacity), handler_(std::move(handler)) {
+  workers_.reserve(workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back([this] { Work(); });
+  }
+}
+
+CallbackDispatcher::~CallbackDispatcher() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+bool CallbackDispatcher::Dispatch(const srpc::SocketAddress &to_addr,
+                                  const SeatAvailabilityCallbackRequest &req) {
+  {
+    std::lock_guard lock{mutex_};
+    if (jobs_.size() >= capacity_) {
+      ++metrics_.dropped;
+      return false;
+    }
+    jobs_.push_back(Job{
+        .to_addr = to_addr,
+        .req = req,
+    });
+    ++metrics_.dispatched;
+    metrics_.max_queued = std::max(metrics_.max_queued, jobs_.size());
+  }
+  cv_.notify_one();
+  return true;
+}
+
+CallbackDispatcherMetrics CallbackDispatcher::Metrics() const {
+  std::lock_guard lock{mutex_};
+  auto metrics = metrics_;
+  metrics.queued = jobs_.size();
+  return metrics;
+}
+
+void CallbackDispatcher::Work() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock lock{mutex_};
+      cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    handler_(job.to_addr, job.req);
+    {
+      std::lock_guard lock{mutex_};
+      ++metrics_.completed;
+    }
+  }
+}
+
+}  // namespace dfis
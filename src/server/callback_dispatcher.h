@@ -0,0 +1,72 @@
+#ifndef DFIS_SERVER_CALLBACK_DISPATCHER_H_
+#define DFIS_SERVER_CALLBACK_DISPATCHER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+#include "messages/seat_availability.h"
+
+namespace dfis {
+
+struct CallbackDispatcherMetrics {
+  srpc::u64 dispatched;
+  srpc::u64 dropped;
+  srpc::u64 completed;
+  std::size_t queued;
+  std::size_t max_queued;
+};
+
+std::ostream &operator<<(std::ostream &os,
+                         const CallbackDispatcherMetrics &metrics);
+
+// Delivers seat availability callbacks on a fixed pool of worker threads. The
+// queue is bounded; callbacks dispatched while it is full are dropped, so that
+// a flight with many monitors cannot stall the server or exhaust its threads.
+class CallbackDispatcher {
+ public:
+  using Handler = std::function<void(const srpc::SocketAddress &to_addr,
+                                     SeatAvailabilityCallbackRequest req)>;
+
+  CallbackDispatcher(std::size_t workers, std::size_t capacity,
+                     Handler handler);
+  CallbackDispatcher(const CallbackDispatcher &) = delete;
+  CallbackDispatcher &operator=(const CallbackDispatcher &) = delete;
+  ~CallbackDispatcher();
+
+  // Queues a callback. Returns false if the queue is full and the callback is
+  // dropped.
+  bool Dispatch(const srpc::SocketAddress &to_addr,
+                const SeatAvailabilityCallbackRequest &req);
+
+  [[nodiscard]] CallbackDispatcherMetrics Metrics() const;
+
+ private:
+  struct Job {
+    srpc::SocketAddress to_addr;
+    SeatAvailabilityCallbackRequest req;
+  };
+
+  void Work();
+
+  std::size_t capacity_;
+  Handler handler_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Job> jobs_;
+  bool stopping_ = false;
+  CallbackDispatcherMetrics metrics_{};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_CALLBACK_DISPATCHER_H_
@@ -0,0 +1,42 @@
+#include "server/callback_sender.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/seat_availability.h"
+#include "messages/wire.h"
+#include "network/datagram_socket.h"
+
+namespace dfis {
+
+std::unique_ptr<CallbackSender> CallbackSender::New(std::string *error) {
+  auto socket = DatagramSocket::New(0, error);
+  if (socket == nullptr) {
+    return nullptr;
+  }
+  return std::unique_ptr<CallbackSender>{new CallbackSender{std::move(socket)}};
+}
+
+CallbackSender::CallbackSender(std::unique_ptr<DatagramSocket> socket)
+    : socket_(std::move(socket)) {}
+
+bool CallbackSender::Send(const srpc::SocketAddress &to_addr,
+                          const SeatAvailabilityCallbackRequest &req,
+                          std::string *error) {
+  // Callbacks are fixed in size, so they are marshalled on the stack.
+  std::array<std::byte, kSerializedSize<SeatAvailabilityCallbackRequest>>
+      buffer;
+  ByteWriter writer{std::span<std::byte>{buffer}};
+  srpc::Marshal<SeatAvailabilityCallbackRequest>{}(req, writer);
+  return socket_->SendTo(to_addr, buffer, error);
+}
+
+}  // namespace dfis
@@ -0,0 +1,37 @@
+#ifndef DFIS_SERVER_CALLBACK_SENDER_H_
+#define DFIS_SERVER_CALLBACK_SENDER_H_
+
+#include <memory>
+#include <string>
+
+#include <srpc/network/tcp_ip.h>
+
+#include "messages/seat_availability.h"
+#include "network/datagram_socket.h"
+
+namespace dfis {
+
+// Sends seat availability callbacks from one long-lived socket. Callbacks are
+// one-way: each is sent once, and receivers recover lost ones by sequence
+// number. Safe to use from multiple threads.
+class CallbackSender {
+ public:
+  [[nodiscard]] static std::unique_ptr<CallbackSender> New(
+      std::string *error = nullptr);
+
+  CallbackSender(const CallbackSender &) = delete;
+  CallbackSender &operator=(const CallbackSender &) = delete;
+
+  bool Send(const srpc::SocketAddress &to_addr,
+            const SeatAvailabilityCallbackRequest &req,
+            std::string *error = nullptr);
+
+ private:
+  explicit CallbackSender(std::unique_ptr<DatagramSocket> socket);
+
+  std::unique_ptr<DatagramSocket> socket_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_CALLBACK_SENDER_H_
@@ -0,0 +1,131 @@
+#include "server/flight_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+
+#include "messages/flight.h"
+
+namespace dfis {
+
+FlightStore::FlightStore(const std::vector<Flight> &flights)
+    : seats_(flights.size()) {
+  schedules_.reserve(flights.size());
+  for (const auto &flight : flights) {
+    if (slots_.contains(flight.identifier)) {
+      continue;
+    }
+    auto slot = schedules_.size();
+    slots_.emplace(flight.identifier, slot);
+    schedules_.push_back(FlightSchedule{
+        .identifier = flight.identifier,
+        .source = flight.source,
+        .destination = flight.destination,
+        .departure_time = flight.departure_time,
+        .airfare = flight.airfare,
+    });
+    seats_[slot].seat_availability.store(flight.seat_availability,
+                                         std::memory_order_relaxed);
+    auto &route = routes_[Route{flight.source, flight.destination}];
+    route.slots.push_back(slot);
+    route.identifiers.push_back(flight.identifier);
+    fares_.push_back(slot);
+  }
+  for (auto &[route, index] : routes_) {
+    std::stable_sort(index.slots.begin(), index.slots.end(),
+                     [this](auto a, auto b) {
+                       return schedules_[a].departure_time <
+                              schedules_[b].departure_time;
+                     });
+    std::sort(index.identifiers.begin(), index.identifiers.end());
+  }
+  std::sort(fares_.begin(), fares_.end(), [this](auto a, auto b) {
+    return std::pair{schedules_[a].airfare, schedules_[a].identifier} <
+           std::pair{schedules_[b].airfare, schedules_[b].identifier};
+  });
+}
+
+std::optional<std::size_t> FlightStore::Find(srpc::i32 identifier) const {
+  auto it = slots_.find(identifier);
+  if (it == slots_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::span<const std::size_t> FlightStore::RouteSlots(RouteRef route) const {
+  auto it = routes_.find(route);
+  if (it == routes_.end()) {
+    return {};
+  }
+  return it->second.slots;
+}
+
+std::span<const srpc::i32> FlightStore::RouteIdentifiers(
+    RouteRef route) const {
+  auto it = routes_.find(route);
+  if (it == routes_.end()) {
+    return {};
+  }
+  return it->second.identifiers;
+}
+
+std::pair<std::size_t, std::size_t> FlightStore::FareRange(
+    srpc::f32 from, srpc::f32 to) const {
+  if (!(from <= to)) {
+    return {0, 0};
+  }
+  auto first = std::partition_point(fares_.begin(), fares_.end(),
+                                    [this, from](auto slot) {
+                                      return schedules_[slot].airfare < from;
+                                    });
+  auto last = std::partition_point(first, fares_.end(), [this, to](auto slot) {
+    return schedules_[slot].airfare <= to;
+  });
+  return {static_cast<std::size_t>(first - fares_.begin()),
+          static_cast<std::size_t>(last - fares_.begin())};
+}
+
+srpc::i32 FlightStore::SeatAvailability(std::size_t slot) const {
+  return seats_[slot].seat_availability.load(std::memory_order_relaxed);
+}
+
+Flight FlightStore::Get(std::size_t slot) const {
+  const auto &schedule = schedules_[slot];
+  return Flight{
+      .identifier = schedule.identifier,
+      .source = schedule.source,
+      .destination = schedule.destination,
+      .departure_time = schedule.departure_time,
+      .airfare = schedule.airfare,
+      .seat_availability = SeatAvailability(slot),
+  };
+}
+
+std::optional<srpc::i32> FlightStore::Reserve(std::size_t slot,
+                                              srpc::i32 seats) {
+  auto &counter = seats_[slot].seat_availability;
+  auto available = counter.load(std::memory_order_relaxed);
+  do {
+    if (available < seats) {
+      return {};
+    }
+  } while (!counter.compare_exchange_weak(available, available - seats,
+                                          std::memory_order_relaxed));
+  return available - seats;
+}
+
+srpc::i32 FlightStore::Release(std::size_t slot, srpc::i32 seats) {
+  return seats_[slot].seat_availability.fetch_add(seats,
+                                                  std::memory_order_relaxed) +
+         seats;
+}
+
+}  // namespace dfis
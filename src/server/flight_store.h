@@ -0,0 +1,154 @@
+#ifndef DFIS_SERVER_FLIGHT_STORE_H_
+#define DFIS_SERVER_FLIGHT_STORE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+
+#include "messages/flight.h"
+
+namespace dfis {
+
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// The read-mostly part of a flight. It never changes after the store is built.
+struct FlightSchedule {
+  srpc::i32 identifier;
+  std::string source;
+  std::string destination;
+  srpc::i64 departure_time;
+  srpc::f32 airfare;
+};
+
+struct Route {
+  std::string source;
+  std::string destination;
+
+  bool operator==(const Route &other) const = default;
+};
+
+// A route named by views, so that it can be looked up without copying names.
+struct RouteRef {
+  std::string_view source;
+  std::string_view destination;
+};
+
+struct RouteHash {
+  using is_transparent = void;
+
+  std::size_t operator()(RouteRef route) const {
+    auto hash = std::hash<std::string_view>{};
+    return hash(route.source) * 31 + hash(route.destination);
+  }
+
+  std::size_t operator()(const Route &route) const {
+    return (*this)(RouteRef{route.source, route.destination});
+  }
+};
+
+struct RouteEqual {
+  using is_transparent = void;
+
+  bool operator()(const Route &lhs, const Route &rhs) const {
+    return lhs == rhs;
+  }
+
+  bool operator()(const Route &lhs, RouteRef rhs) const {
+    return lhs.source == rhs.source && lhs.destination == rhs.destination;
+  }
+
+  bool operator()(RouteRef lhs, const Route &rhs) const {
+    return (*this)(rhs, lhs);
+  }
+};
+
+// The only mutable part of a flight. Each counter occupies a cache line of its
+// own, so that writing to it invalidates neither other counters nor schedules.
+struct alignas(kCacheLineSize) SeatCounter {
+  std::atomic<srpc::i32> seat_availability;
+};
+
+// Flights split into two parallel arrays indexed by slot: schedules (cold) and
+// seat counters (hot).
+class FlightStore {
+ public:
+  explicit FlightStore(const std::vector<Flight> &flights);
+
+  [[nodiscard]] std::size_t Size() const { return schedules_.size(); }
+
+  [[nodiscard]] std::optional<std::size_t> Find(srpc::i32 identifier) const;
+
+  [[nodiscard]] const FlightSchedule &Schedule(std::size_t slot) const {
+    return schedules_[slot];
+  }
+
+  [[nodiscard]] const std::vector<FlightSchedule> &Schedules() const {
+    return schedules_;
+  }
+
+  // Slots of the flights on the route, ordered by departure time.
+  [[nodiscard]] std::span<const std::size_t> RouteSlots(RouteRef route) const;
+
+  // Identifiers of the flights on the route, in ascending order.
+  [[nodiscard]] std::span<const srpc::i32> RouteIdentifiers(
+      RouteRef route) const;
+
+  // Slots of all flights, ordered by airfare and then by identifier.
+  [[nodiscard]] std::span<const std::size_t> FareSlots() const {
+    return fares_;
+  }
+
+  // The positions [first, last) in FareSlots() of the flights with an airfare
+  // within [from, to].
+  [[nodiscard]] std::pair<std::size_t, std::size_t> FareRange(
+      srpc::f32 from, srpc::f32 to) const;
+
+  [[nodiscard]] srpc::i32 SeatAvailability(std::size_t slot) const;
+
+  // Hints that the flight is about to be used, so that its schedule and seat
+  // counter can be fetched into cache in the meantime.
+  void Prefetch(std::size_t slot) const {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&schedules_[slot]);
+    __builtin_prefetch(&seats_[slot]);
+#endif
+  }
+
+  // Assembles a full flight record from both halves.
+  [[nodiscard]] Flight Get(std::size_t slot) const;
+
+  // Takes the given number of seats if enough are left, and returns the number
+  // of seats remaining afterwards.
+  [[nodiscard]] std::optional<srpc::i32> Reserve(std::size_t slot,
+                                                 srpc::i32 seats);
+
+  // Gives back the given number of seats, and returns the number of seats
+  // available afterwards.
+  srpc::i32 Release(std::size_t slot, srpc::i32 seats);
+
+ private:
+  std::vector<FlightSchedule> schedules_;
+  std::vector<SeatCounter> seats_;
+  struct RouteIndex {
+    std::vector<std::size_t> slots;
+    std::vector<srpc::i32> identifiers;
+  };
+
+  std::unordered_map<srpc::i32, std::size_t> slots_;
+  std::unordered_map<Route, RouteIndex, RouteHash, RouteEqual> routes_;
+  std::vector<std::size_t> fares_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_FLIGHT_STORE_H_
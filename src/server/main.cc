@@ -1,13 +1,15 @@
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
-#include <functional>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <random>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -15,20 +17,31 @@
 #include <utility>
 #include <vector>
 
-#include <srpc/network/datagram_client.h>
-#include <srpc/network/datagram_server.h>
 #include <srpc/network/tcp_ip.h>
 #include <srpc/types/floats.h>
 #include <srpc/types/integers.h>
 #include <srpc/types/serialization.h>
-#include <srpc/utils/result.h>
 
+#include "messages/batch.h"
 #include "messages/flight.h"
 #include "messages/flight_info.h"
 #include "messages/flight_search.h"
+#include "messages/fragment.h"
+#include "messages/id_list.h"
 #include "messages/invocation_semantic.h"
+#include "messages/message_type.h"
 #include "messages/seat_availability.h"
 #include "messages/seat_reservation.h"
+#include "messages/timed_request.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+#include "network/fragmentation.h"
+#include "server/callback_dispatcher.h"
+#include "server/callback_sender.h"
+#include "server/flight_store.h"
+#include "server/multicast_publisher.h"
+#include "server/notifier.h"
+#include "server/pagination.h"
 #include "utils/rand.h"
 #include "utils/time.h"
 
@@ -36,9 +49,13 @@ using namespace dfis;
 
 namespace {
 
-std::unordered_map<srpc::i32, Flight> ReadFlightsFromFile(
-    const std::string &filename) {
-  std::unordered_map<srpc::i32, Flight> flights;
+constexpr std::size_t kCallbackWorkers = 4;
+constexpr std::size_t kCallbackQueueCapacity = 4096;
+constexpr std::size_t kSentFragmentsCapacity = 64;
+constexpr std::size_t kMaxBatchSize = 256;
+
+std::vector<Flight> ReadFlightsFromFile(const std::string &filename) {
+  std::vector<Flight> flights;
   std::ifstream in{filename};
   for (;;) {
     std::string line;
@@ -54,7 +71,7 @@ std::unordered_map<srpc::i32, Flight> ReadFlightsFromFile(
     ss >> flight.airfare;
     ss >> flight.seat_availability;
     std::clog << "Info: Read flight " << flight << std::endl;
-    flights.emplace(flight.identifier, std::move(flight));
+    flights.push_back(std::move(flight));
   }
   return flights;
 }
@@ -84,117 +101,288 @@ bool RandomLoss(srpc::f32 loss_prob = 0.1) {
   return std::uniform_real_distribution<srpc::f32>{0.0, 1.0}(rand) < loss_prob;
 }
 
-void SendSeatAvailabilityCallbackRequest(const srpc::SocketAddress &to_addr,
+// Lists flights in the encoding the request asked for, if it is supported.
+IdList MakeIdList(IdListEncoding encoding, std::vector<srpc::i32> flights) {
+  return IdList{
+      .encoding = IsValidIdListEncoding(static_cast<srpc::i8>(encoding))
+                      ? encoding
+                      : IdListEncoding::kFixed,
+      .ids = std::move(flights),
+  };
+}
+
+void SendSeatAvailabilityCallbackRequest(CallbackSender &sender,
+                                         const srpc::SocketAddress &to_addr,
                                          SeatAvailabilityCallbackRequest req) {
-  auto client_res = srpc::DatagramClient::New(to_addr.address, to_addr.port);
-  if (!client_res.OK()) {
-    std::cerr
-        << "Error: Unable to create client for seat availability callback to "
-        << to_addr << ": " << client_res.Error() << std::endl;
-    return;
+  req.id = MakeMessageIdentifier();
+  std::clog << "Info: Sending callback " << req << " to " << to_addr
+            << std::endl;
+  std::string error;
+  if (!sender.Send(to_addr, req, &error)) {
+    std::cerr << "Error: Unable to send seat availability callback to "
+              << to_addr << ": " << error << std::endl;
   }
+}
 
-  auto client = std::move(client_res.Value());
-  req.id = MakeMessageIdentifier();
+void NotifySubscribers(Notifier &notifier, CallbackDispatcher &dispatcher,
+                       MulticastPublisher *multicast,
+                       const FlightSchedule &schedule,
+                       srpc::i32 seat_availability) {
+  auto result = notifier.Publish(schedule, seat_availability);
+  std::clog << "Info: Notified subscribers of flight " << schedule.identifier
+            << ": " << result << std::endl;
+  std::string error;
+  if (multicast != nullptr &&
+      multicast->Publish(schedule.identifier, seat_availability, &error)) {
+    std::clog << "Info: Multicast update of flight " << schedule.identifier
+              << " to " << MulticastPublisher::Group(schedule.identifier)
+              << std::endl;
+  } else if (!error.empty()) {
+    std::cerr << "Error: Unable to multicast update of flight "
+              << schedule.identifier << ": " << error << std::endl;
+  }
+  std::clog << "Info: Callback dispatcher: " << dispatcher.Metrics()
+            << std::endl;
+}
 
-  std::vector<std::byte> resp_bytes;
-  constexpr int retry_times = 3;
-  int attempt = 0;
-  while (attempt <= retry_times) {
-    auto resp_bytes_res = client->SendAndReceive(
-        srpc::Marshal<SeatAvailabilityCallbackRequest>{}(req));
-    if (!resp_bytes_res.OK()) {
-      std::clog << "Error: Unable to receive response for seat availability "
-                   "callback to "
-                << to_addr << ": " << resp_bytes_res.Error() << std::endl;
-      if (++attempt <= retry_times) {
-        std::clog << "Info: Retrying; attempt " << attempt << std::endl;
-      }
-      continue;
+// Simulates the loss and delay of messages, unless disabled.
+class Simulation {
+ public:
+  explicit Simulation(bool enabled) : enabled_(enabled) {}
+
+  [[nodiscard]] bool Loss(srpc::f32 loss_prob) const {
+    return enabled_ && RandomLoss(loss_prob);
+  }
+
+  void Delay() const {
+    if (enabled_) {
+      RandomDelay();
     }
-    resp_bytes = std::move(resp_bytes_res.Value());
-    break;
   }
-  if (attempt > retry_times) {
-    std::cerr << "Error: Unable to receive response for seat availability "
-                 "callback to "
-              << to_addr << " after " << retry_times << " retries" << std::endl;
-    return;
+
+ private:
+  bool enabled_;
+};
+
+// When the client gives up on a request; Deadline::max() if never.
+using Deadline = std::chrono::system_clock::time_point;
+
+// Whether the client has given up on the request, which is then shed rather
+// than served.
+bool Expired(Deadline deadline, srpc::u64 id) {
+  if (std::chrono::system_clock::now() < deadline) {
+    return false;
   }
+  std::clog << "Info: Shedding request " << id
+            << ", as its deadline has passed" << std::endl;
+  return true;
+}
 
-  auto resp_res =
-      srpc::Unmarshal<SeatAvailabilityCallbackResponse>{}(resp_bytes);
-  if (!resp_res.second.has_value()) {
-    std::cerr
-        << "Error: Invalid response received for seat availability callback to "
-        << to_addr << std::endl;
-    return;
+template <typename Req>
+std::optional<srpc::i32> IdentifierOf(std::span<const std::byte> req_data) {
+  auto req_res = srpc::Unmarshal<Req>{}(req_data);
+  if (!req_res.second.has_value()) {
+    return {};
   }
+  return req_res.second->identifier;
+}
 
-  auto resp = *resp_res.second;
-  if (resp.status_code != 0) {
-    std::cerr
-        << "Error: Received non-zero seat availability callback status code "
-        << resp.status_code << " from " << to_addr << std::endl;
+// The flight a marshalled request refers to, if any.
+std::optional<srpc::i32> FlightIdentifierOf(
+    std::span<const std::byte> req_data) {
+  auto header = Decode<MessageHeader>(req_data).second;
+  if (!header.has_value()) {
+    return {};
+  }
+  switch (MessageType{header->type}) {
+    case MessageType::kFlightInfoRequest:
+      return IdentifierOf<FlightInfoRequest>(req_data);
+    case MessageType::kSeatReservationRequest:
+      return IdentifierOf<SeatReservationRequest>(req_data);
+    case MessageType::kSeatReservationCancellationRequest:
+      return IdentifierOf<SeatReservationCancellationRequest>(req_data);
+    case MessageType::kSeatAvailabilityMonitoringRequest:
+      return IdentifierOf<SeatAvailabilityMonitoringRequest>(req_data);
+    case MessageType::kMulticastMonitoringRequest:
+      return IdentifierOf<MulticastMonitoringRequest>(req_data);
+    default: return {};
+  }
+}
+
+// Sends a response, split into fragments if it is too large for one datagram.
+// Fragments are kept in sent, so that any lost can be sent again on request.
+void SendResponse(DatagramSocket &socket, SentFragments &sent,
+                  const srpc::SocketAddress &to_addr,
+                  const std::vector<std::byte> &res_data,
+                  const Simulation &simulation) {
+  std::string error;
+  if (res_data.size() <= kMaxFragmentPayload) {
+    if (!socket.SendTo(to_addr, res_data, &error)) {
+      std::cerr << "Error: Unable to send response to " << to_addr << ": "
+                << error << std::endl;
+    }
     return;
   }
+  auto header = Decode<MessageHeader>(res_data).second;
+  auto message_id = MakeMessageIdentifier();
+  auto fragments =
+      SplitIntoFragments(header.has_value() ? header->id : 0, message_id,
+                         res_data);
+  if (!fragments.has_value()) {
+    std::cerr << "Error: Response of " << res_data.size()
+              << " bytes is too large to send" << std::endl;
+    return;
+  }
+  std::clog << "Info: Sending response as " << fragments->size()
+            << " fragments of " << message_id << std::endl;
+  for (std::size_t i = 0; i < fragments->size(); ++i) {
+    if (simulation.Loss(0.05)) {
+      std::clog << "Info: Fragment " << i + 1 << " of " << message_id
+                << " is simulated to be lost" << std::endl;
+      continue;
+    }
+    if (!socket.SendTo(to_addr, (*fragments)[i], &error)) {
+      std::cerr << "Error: Unable to send fragment to " << to_addr << ": "
+                << error << std::endl;
+    }
+  }
+  sent.Add(message_id, std::move(*fragments));
+}
 
-  std::clog
-      << "Info: Successfully received seat availability callback response from "
-      << to_addr << std::endl;
+void RetransmitFragments(DatagramSocket &socket, const SentFragments &sent,
+                         const srpc::SocketAddress &to_addr,
+                         const FragmentRetransmitRequest &req) {
+  std::clog << "Info: Received fragment retransmit request from " << to_addr
+            << ": " << req << std::endl;
+  std::string error;
+  for (auto index : req.missing) {
+    const auto *fragment = sent.Find(req.message_id, index);
+    if (fragment == nullptr) {
+      std::clog << "Info: Fragment " << index + 1 << " of " << req.message_id
+                << " is no longer kept" << std::endl;
+      continue;
+    }
+    if (!socket.SendTo(to_addr, *fragment, &error)) {
+      std::cerr << "Error: Unable to send fragment to " << to_addr << ": "
+                << error << std::endl;
+    }
+  }
 }
 
 std::optional<std::vector<std::byte>> Serve(
-    InvocationSemantic semantic,
-    const std::unordered_map<srpc::i32, Flight> &flights_input,
-    const srpc::SocketAddress &from_addr,
-    srpc::Result<std::vector<std::byte>> req_data_res) {
-  struct Callback {
-    srpc::SocketAddress to_addr;
-    std::chrono::system_clock::time_point monitor_end;
-  };
-
+    InvocationSemantic semantic, FlightStore &flights,
+    Notifier &notifier, CallbackDispatcher &dispatcher,
+    MulticastPublisher *multicast, const srpc::SocketAddress &from_addr,
+    std::span<const std::byte> req_data, const Simulation &simulation,
+    Deadline deadline) {
   struct Reservation {
     srpc::i32 identifier;
+    std::size_t slot;
     srpc::i32 seats;
   };
 
-  static bool initialised = false;
-  static std::unordered_map<srpc::i32, Flight> flights;
-  static std::unordered_map<srpc::i32, std::vector<Callback>> callbacks;
   static std::unordered_map<srpc::u64, Reservation> reservations;
 
-  if (!initialised) {
-    flights = flights_input;
-    initialised = true;
-  }
+  {
+    auto req_res = srpc::Unmarshal<BatchRequestView>{}(req_data);
+    if (req_res.second.has_value()) {
+      // Valid for as long as req_data is.
+      const auto &req = *req_res.second;
+      std::clog << "Info: Received batch request from " << from_addr << ": "
+                << req << std::endl;
+
+      // The batch is lost or delayed as a whole, never the requests within it.
+      // Each of those is deduplicated by its own history, so the batch keeps
+      // none.
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
+      if (req_lost) {
+        std::clog << "Info: Request " << req.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
-  if (!req_data_res.OK()) {
-    std::cerr << "Error: Could not receive request from " << from_addr << ": "
-              << req_data_res.Error() << std::endl;
-    return {};
+      BatchResponse res;
+      if (req.requests.empty()) {
+        res.id = req.id;
+        res.status_code = 1;
+        res.message = "No requests";
+        res.responses = {};
+      } else if (req.requests.size() > kMaxBatchSize) {
+        res.id = req.id;
+        res.status_code = 2;
+        res.message = "Too many requests";
+        res.responses = {};
+      } else {
+        // Looking up every flight the batch touches first lets their records
+        // be fetched from memory together, rather than one request at a time.
+        for (auto sub_req_data : req.requests) {
+          auto identifier = FlightIdentifierOf(sub_req_data);
+          if (!identifier.has_value()) {
+            continue;
+          }
+          if (auto slot = flights.Find(*identifier); slot.has_value()) {
+            flights.Prefetch(*slot);
+          }
+        }
+        res.id = req.id;
+        res.status_code = 0;
+        res.message = {};
+        res.responses.reserve(req.requests.size());
+        for (auto sub_req_data : req.requests) {
+          std::optional<std::vector<std::byte>> sub_res_data;
+          // Batches do not nest.
+          auto nested_res = srpc::Unmarshal<BatchRequestView>{}(sub_req_data);
+          if (!nested_res.second.has_value()) {
+            sub_res_data = Serve(semantic, flights, notifier, dispatcher,
+                                 multicast, from_addr, sub_req_data,
+                                 Simulation{false}, deadline);
+          }
+          res.responses.push_back(
+              std::move(sub_res_data).value_or(std::vector<std::byte>{}));
+        }
+      }
+
+      if (res_lost) {
+        std::clog << "Info: Response " << res.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+
+      std::clog << "Info: Sending batch response to " << from_addr << ": "
+                << res << std::endl;
+      return srpc::Marshal<BatchResponse>{}(res);
+    }
   }
-  auto req_data = std::move(req_data_res.Value());
 
   {
-    auto req_res = srpc::Unmarshal<FlightSearchRequest>{}(req_data);
+    auto req_res = srpc::Unmarshal<FlightSearchRequestView>{}(req_data);
     if (req_res.second.has_value()) {
       static std::unordered_map<
           srpc::u64, std::pair<FlightSearchRequest, FlightSearchResponse>>
           history;
 
-      auto req = std::move(*req_res.second);
+      // Valid for as long as req_data is.
+      auto req = *req_res.second;
       std::clog << "Info: Received flight search request from " << from_addr
                 << ": " << req << std::endl;
 
-      auto req_lost = RandomLoss(0.1);
-      auto res_lost = RandomLoss(0.2);
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
       if (req_lost) {
         std::clog << "Info: Request " << req.id << " is simulated to be lost"
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
       if (semantic == InvocationSemantic::kAtMostOnce &&
           history.contains(req.id)) {
@@ -206,33 +394,33 @@ std::optional<std::vector<std::byte>> Serve(
                     << std::endl;
           return {};
         }
-        RandomDelay();
+        simulation.Delay();
         std::clog << "Info: Returning saved response " << res << std::endl;
         return srpc::Marshal<FlightSearchResponse>{}(res);
       }
 
       FlightSearchResponse res;
-      std::vector<srpc::i32> results;
-      for (const auto &flight : flights) {
-        if (flight.second.source == req.source &&
-            flight.second.destination == req.destination) {
-          results.emplace_back(flight.second.identifier);
-        }
-      }
-      std::sort(results.begin(), results.end(), std::less<srpc::i32>{});
+      auto identifiers =
+          flights.RouteIdentifiers(RouteRef{req.source, req.destination});
+      auto page =
+          SelectPage(0, identifiers.size(), req.cursor, req.page_size);
+      std::vector<srpc::i32> results{identifiers.begin() + page.begin,
+                                     identifiers.begin() + page.end};
       if (results.empty()) {
         res.id = req.id;
         res.status_code = 1;
         res.message = "Flights not found";
-        res.flights = std::move(results);
+        res.flights = MakeIdList(req.encoding, std::move(results));
+        res.next_cursor = 0;
       } else {
         res.id = req.id;
         res.status_code = 0;
         res.message = {};
-        res.flights = std::move(results);
+        res.flights = MakeIdList(req.encoding, std::move(results));
+        res.next_cursor = page.next_cursor;
       }
       if (semantic == InvocationSemantic::kAtMostOnce) {
-        history[req.id] = {req, res};
+        history[req.id] = {req.ToRequest(), res};
       }
 
       if (res_lost) {
@@ -240,7 +428,7 @@ std::optional<std::vector<std::byte>> Serve(
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
 
       std::clog << "Info: Sending flight search response to " << from_addr
                 << ": " << res << std::endl;
@@ -259,14 +447,17 @@ std::optional<std::vector<std::byte>> Serve(
       std::clog << "Info: Received flight info request from " << from_addr
                 << ": " << req << std::endl;
 
-      auto req_lost = RandomLoss(0.1);
-      auto res_lost = RandomLoss(0.2);
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
       if (req_lost) {
         std::clog << "Info: Request " << req.id << " is simulated to be lost"
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
       if (semantic == InvocationSemantic::kAtMostOnce &&
           history.contains(req.id)) {
@@ -278,13 +469,14 @@ std::optional<std::vector<std::byte>> Serve(
                     << std::endl;
           return {};
         }
-        RandomDelay();
+        simulation.Delay();
         std::clog << "Info: Returning saved response " << res << std::endl;
         return srpc::Marshal<FlightInfoResponse>{}(res);
       }
 
       FlightInfoResponse res;
-      if (!flights.contains(req.identifier)) {
+      auto slot = flights.Find(req.identifier);
+      if (!slot.has_value()) {
         res.id = req.id;
         res.status_code = 1;
         res.message = "Flight not found";
@@ -293,7 +485,7 @@ std::optional<std::vector<std::byte>> Serve(
         res.id = req.id;
         res.status_code = 0;
         res.message = {};
-        res.flight = {flights[req.identifier]};
+        res.flight = {flights.Get(*slot)};
       }
       if (semantic == InvocationSemantic::kAtMostOnce) {
         history[req.id] = {req, res};
@@ -304,7 +496,7 @@ std::optional<std::vector<std::byte>> Serve(
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
 
       std::clog << "Info: Sending flight info response to " << from_addr << ": "
                 << res << std::endl;
@@ -323,14 +515,17 @@ std::optional<std::vector<std::byte>> Serve(
       std::clog << "Info: Received seat reservation request from " << from_addr
                 << ": " << req << std::endl;
 
-      auto req_lost = RandomLoss(0.1);
-      auto res_lost = RandomLoss(0.2);
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
       if (req_lost) {
         std::clog << "Info: Request " << req.id << " is simulated to be lost"
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
       if (semantic == InvocationSemantic::kAtMostOnce &&
           history.contains(req.id)) {
@@ -342,22 +537,22 @@ std::optional<std::vector<std::byte>> Serve(
                     << std::endl;
           return {};
         }
-        RandomDelay();
+        simulation.Delay();
         std::clog << "Info: Returning saved response " << res << std::endl;
         return srpc::Marshal<SeatReservationResponse>{}(res);
       }
 
       SeatReservationResponse res;
-      if (!flights.contains(req.identifier)) {
+      auto slot = flights.Find(req.identifier);
+      if (!slot.has_value()) {
         res.id = req.id;
         res.status_code = 1;
         res.message = "Flight not found";
         res.identifier = req.identifier;
         res.seats = 0;
       } else {
-        auto &flight = flights[req.identifier];
-        // Note: for simplicity, race condition is not handled.
-        if (flight.seat_availability < req.seats) {
+        auto seats_left = flights.Reserve(*slot, req.seats);
+        if (!seats_left.has_value()) {
           res.id = req.id;
           res.status_code = 2;
           res.message = "No enough seats";
@@ -365,35 +560,19 @@ std::optional<std::vector<std::byte>> Serve(
           res.seats = 0;
         } else {
           res.id = req.id;
-          flight.seat_availability -= req.seats;
-          std::clog << "Info: Flight " << flight.identifier << " now has "
-                    << flight.seat_availability << " seat(s) left" << std::endl;
+          std::clog << "Info: Flight " << req.identifier << " now has "
+                    << *seats_left << " seat(s) left" << std::endl;
           res.status_code = 0;
           res.message = {};
           res.identifier = req.identifier;
           res.seats = req.seats;
           reservations.emplace(req.id, Reservation{
                                            .identifier = req.identifier,
+                                           .slot = *slot,
                                            .seats = req.seats,
                                        });
-          // Note: for simplicity, expired callbacks are not handled.
-          auto now = std::chrono::system_clock::now();
-          SeatAvailabilityCallbackRequest cb_req{
-              .identifier = flight.identifier,
-              .seat_availability = flight.seat_availability,
-          };
-          for (const auto &callback : callbacks[req.identifier]) {
-            if (now < callback.monitor_end) {
-              std::clog << "Info: Sending callback " << cb_req << " to "
-                        << callback.to_addr << std::endl;
-              std::thread{SendSeatAvailabilityCallbackRequest, callback.to_addr,
-                          cb_req}
-                  .detach();
-            } else {
-              std::clog << "Info: Callback to " << callback.to_addr
-                        << " is expired" << std::endl;
-            }
-          }
+          NotifySubscribers(notifier, dispatcher, multicast,
+                            flights.Schedule(*slot), *seats_left);
         }
       }
       if (semantic == InvocationSemantic::kAtMostOnce) {
@@ -405,7 +584,7 @@ std::optional<std::vector<std::byte>> Serve(
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
 
       std::clog << "Info: Sending seat reservation response to " << from_addr
                 << ": " << res << std::endl;
@@ -426,14 +605,17 @@ std::optional<std::vector<std::byte>> Serve(
       std::clog << "Info: Received seat availability monitoring request from "
                 << from_addr << ": " << req << std::endl;
 
-      auto req_lost = RandomLoss(0.1);
-      auto res_lost = RandomLoss(0.2);
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
       if (req_lost) {
         std::clog << "Info: Request " << req.id << " is simulated to be lost"
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
       if (semantic == InvocationSemantic::kAtMostOnce &&
           history.contains(req.id)) {
@@ -445,22 +627,29 @@ std::optional<std::vector<std::byte>> Serve(
                     << std::endl;
           return {};
         }
-        RandomDelay();
+        simulation.Delay();
         std::clog << "Info: Returning saved response " << res << std::endl;
         return srpc::Marshal<SeatAvailabilityMonitoringResponse>{}(res);
       }
 
       SeatAvailabilityMonitoringResponse res;
-      if (!flights.contains(req.identifier)) {
+      auto slot = flights.Find(req.identifier);
+      if (!slot.has_value()) {
         res.id = req.id;
         res.status_code = 1;
         res.message = "Flight not found";
         res.identifier = req.identifier;
+        res.subscription = 0;
+        res.monitor_end = 0;
+      } else if (!IsValidSeatAvailabilityTrigger(
+                     static_cast<srpc::i8>(req.trigger))) {
+        res.id = req.id;
+        res.status_code = 2;
+        res.message = "Invalid trigger";
+        res.identifier = req.identifier;
+        res.subscription = 0;
         res.monitor_end = 0;
       } else {
-        if (!callbacks.contains(req.identifier)) {
-          callbacks[req.identifier] = {};
-        }
         auto monitor_end = std::chrono::system_clock::now() +
                            std::chrono::seconds{req.monitor_interval_sec};
         auto monitor_end_ts = std::chrono::duration_cast<std::chrono::seconds>(
@@ -474,14 +663,20 @@ std::optional<std::vector<std::byte>> Serve(
         std::clog << "Info: Monitoring seat availability of flight "
                   << req.identifier << " for " << to_addr << " until "
                   << FormatTimestamp(monitor_end_ts) << std::endl;
-        callbacks[req.identifier].push_back(Callback{
-            .to_addr = to_addr,
-            .monitor_end = monitor_end,
-        });
+        auto subscription = notifier.Subscribe(
+            req.identifier, to_addr, monitor_end,
+            SubscriptionOptions{
+                .coalesce_window = std::chrono::milliseconds{std::max(
+                    req.coalesce_window_ms, 0)},
+                .trigger = req.trigger,
+                .threshold = req.threshold,
+            },
+            flights.SeatAvailability(*slot));
         res.id = req.id;
         res.status_code = 0;
         res.message = {};
         res.identifier = req.identifier;
+        res.subscription = subscription;
         res.monitor_end = monitor_end_ts;
       }
       if (semantic == InvocationSemantic::kAtMostOnce) {
@@ -493,7 +688,7 @@ std::optional<std::vector<std::byte>> Serve(
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
 
       std::clog << "Info: Sending seat availability monitoring response to "
                 << from_addr << ": " << res << std::endl;
@@ -501,6 +696,269 @@ std::optional<std::vector<std::byte>> Serve(
     }
   }
 
+  {
+    auto req_res = srpc::Unmarshal<RouteMonitoringRequestView>{}(req_data);
+    if (req_res.second.has_value()) {
+      static std::unordered_map<
+          srpc::u64, std::pair<RouteMonitoringRequest, RouteMonitoringResponse>>
+          history;
+
+      // Valid for as long as req_data is.
+      auto req = *req_res.second;
+      std::clog << "Info: Received route monitoring request from " << from_addr
+                << ": " << req << std::endl;
+
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
+      if (req_lost) {
+        std::clog << "Info: Request " << req.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
+
+      if (semantic == InvocationSemantic::kAtMostOnce &&
+          history.contains(req.id)) {
+        std::clog << "Info: " << req.id << " is a duplicate request"
+                  << std::endl;
+        auto res = history[req.id].second;
+        if (res_lost) {
+          std::clog << "Info: Response " << res.id << " is simulated to be lost"
+                    << std::endl;
+          return {};
+        }
+        simulation.Delay();
+        std::clog << "Info: Returning saved response " << res << std::endl;
+        return srpc::Marshal<RouteMonitoringResponse>{}(res);
+      }
+
+      RouteMonitoringResponse res;
+      RouteFilter filter{
+          .route = {std::string{req.source}, std::string{req.destination}},
+          .departure_from = req.departure_from,
+          .departure_to = req.departure_to,
+      };
+      std::vector<std::pair<srpc::i32, srpc::i32>> seat_availability;
+      for (auto slot :
+           flights.RouteSlots(RouteRef{req.source, req.destination})) {
+        const auto &schedule = flights.Schedule(slot);
+        if (filter.Matches(schedule)) {
+          seat_availability.emplace_back(schedule.identifier,
+                                         flights.SeatAvailability(slot));
+        }
+      }
+      if (seat_availability.empty()) {
+        res.id = req.id;
+        res.status_code = 1;
+        res.message = "Flights not found";
+        res.flights = {};
+        res.subscription = 0;
+        res.monitor_end = 0;
+      } else if (!IsValidSeatAvailabilityTrigger(
+                     static_cast<srpc::i8>(req.trigger))) {
+        res.id = req.id;
+        res.status_code = 2;
+        res.message = "Invalid trigger";
+        res.flights = {};
+        res.subscription = 0;
+        res.monitor_end = 0;
+      } else {
+        auto monitor_end = std::chrono::system_clock::now() +
+                           std::chrono::seconds{req.monitor_interval_sec};
+        auto monitor_end_ts = std::chrono::duration_cast<std::chrono::seconds>(
+                                  monitor_end.time_since_epoch())
+                                  .count();
+        srpc::SocketAddress to_addr{
+            .protocol = from_addr.protocol,
+            .address = from_addr.address,
+            .port = req.port,
+        };
+        std::clog << "Info: Monitoring seat availability of "
+                  << seat_availability.size() << " flight(s) from "
+                  << req.source << " to " << req.destination << " for "
+                  << to_addr << " until " << FormatTimestamp(monitor_end_ts)
+                  << std::endl;
+        auto subscription = notifier.Subscribe(
+            filter, to_addr, monitor_end,
+            SubscriptionOptions{
+                .coalesce_window = std::chrono::milliseconds{std::max(
+                    req.coalesce_window_ms, 0)},
+                .trigger = req.trigger,
+                .threshold = req.threshold,
+            },
+            seat_availability);
+        res.id = req.id;
+        res.status_code = 0;
+        res.message = {};
+        for (const auto &[identifier, seats] : seat_availability) {
+          res.flights.push_back(identifier);
+        }
+        res.subscription = subscription;
+        res.monitor_end = monitor_end_ts;
+      }
+      if (semantic == InvocationSemantic::kAtMostOnce) {
+        history[req.id] = {req.ToRequest(), res};
+      }
+
+      if (res_lost) {
+        std::clog << "Info: Response " << res.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+
+      std::clog << "Info: Sending route monitoring response to " << from_addr
+                << ": " << res << std::endl;
+      return srpc::Marshal<RouteMonitoringResponse>{}(res);
+    }
+  }
+
+  {
+    auto req_res = srpc::Unmarshal<SeatAvailabilitySnapshotRequest>{}(req_data);
+    if (req_res.second.has_value()) {
+      auto req = *req_res.second;
+      std::clog << "Info: Received seat availability snapshot request from "
+                << from_addr << ": " << req << std::endl;
+
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
+      if (req_lost) {
+        std::clog << "Info: Request " << req.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
+
+      // A snapshot is idempotent, so no history is kept even under the
+      // at-most-once semantic.
+      SeatAvailabilitySnapshotResponse res;
+      auto state = notifier.Snapshot(req.subscription, req.identifier);
+      if (!state.has_value()) {
+        res.id = req.id;
+        res.status_code = 1;
+        res.message = "Subscription not found";
+        res.identifier = req.identifier;
+        res.sequence = 0;
+        res.seat_availability = 0;
+      } else {
+        res.id = req.id;
+        res.status_code = 0;
+        res.message = {};
+        res.identifier = req.identifier;
+        res.sequence = state->sequence;
+        res.seat_availability = state->seat_availability;
+      }
+
+      if (res_lost) {
+        std::clog << "Info: Response " << res.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+
+      std::clog << "Info: Sending seat availability snapshot response to "
+                << from_addr << ": " << res << std::endl;
+      return srpc::Marshal<SeatAvailabilitySnapshotResponse>{}(res);
+    }
+  }
+
+  {
+    auto req_res = srpc::Unmarshal<MulticastMonitoringRequest>{}(req_data);
+    if (req_res.second.has_value()) {
+      static std::unordered_map<
+          srpc::u64,
+          std::pair<MulticastMonitoringRequest, MulticastMonitoringResponse>>
+          history;
+
+      auto req = *req_res.second;
+      std::clog << "Info: Received multicast monitoring request from "
+                << from_addr << ": " << req << std::endl;
+
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
+      if (req_lost) {
+        std::clog << "Info: Request " << req.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
+
+      if (semantic == InvocationSemantic::kAtMostOnce &&
+          history.contains(req.id)) {
+        std::clog << "Info: " << req.id << " is a duplicate request"
+                  << std::endl;
+        auto res = history[req.id].second;
+        if (res_lost) {
+          std::clog << "Info: Response " << res.id << " is simulated to be lost"
+                    << std::endl;
+          return {};
+        }
+        simulation.Delay();
+        std::clog << "Info: Returning saved response " << res << std::endl;
+        return srpc::Marshal<MulticastMonitoringResponse>{}(res);
+      }
+
+      MulticastMonitoringResponse res;
+      if (!flights.Find(req.identifier).has_value()) {
+        res.id = req.id;
+        res.status_code = 1;
+        res.message = "Flight not found";
+        res.identifier = req.identifier;
+        res.group = {};
+        res.port = 0;
+        res.monitor_end = 0;
+      } else if (multicast == nullptr) {
+        res.id = req.id;
+        res.status_code = 2;
+        res.message = "Multicast is disabled";
+        res.identifier = req.identifier;
+        res.group = {};
+        res.port = 0;
+        res.monitor_end = 0;
+      } else {
+        auto monitor_end = std::chrono::system_clock::now() +
+                           std::chrono::seconds{req.monitor_interval_sec};
+        auto monitor_end_ts = std::chrono::duration_cast<std::chrono::seconds>(
+                                  monitor_end.time_since_epoch())
+                                  .count();
+        multicast->Enable(req.identifier, monitor_end);
+        res.id = req.id;
+        res.status_code = 0;
+        res.message = {};
+        res.identifier = req.identifier;
+        res.group = MulticastPublisher::Group(req.identifier);
+        res.port = multicast->Port();
+        res.monitor_end = monitor_end_ts;
+        std::clog << "Info: Multicasting seat availability of flight "
+                  << req.identifier << " to " << res.group << ":" << res.port
+                  << " until " << FormatTimestamp(monitor_end_ts) << std::endl;
+      }
+      if (semantic == InvocationSemantic::kAtMostOnce) {
+        history[req.id] = {req, res};
+      }
+
+      if (res_lost) {
+        std::clog << "Info: Response " << res.id << " is simulated to be lost"
+                  << std::endl;
+        return {};
+      }
+      simulation.Delay();
+
+      std::clog << "Info: Sending multicast monitoring response to "
+                << from_addr << ": " << res << std::endl;
+      return srpc::Marshal<MulticastMonitoringResponse>{}(res);
+    }
+  }
+
   {
     auto req_res = srpc::Unmarshal<PriceRangeSearchRequest>{}(req_data);
     if (req_res.second.has_value()) {
@@ -512,14 +970,17 @@ std::optional<std::vector<std::byte>> Serve(
       std::clog << "Info: Received price range search request from "
                 << from_addr << ": " << req << std::endl;
 
-      auto req_lost = RandomLoss(0.1);
-      auto res_lost = RandomLoss(0.2);
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
       if (req_lost) {
         std::clog << "Info: Request " << req.id << " is simulated to be lost"
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
       if (semantic == InvocationSemantic::kAtMostOnce &&
           history.contains(req.id)) {
@@ -531,30 +992,32 @@ std::optional<std::vector<std::byte>> Serve(
                     << std::endl;
           return {};
         }
-        RandomDelay();
+        simulation.Delay();
         std::clog << "Info: Returning saved response " << res << std::endl;
         return srpc::Marshal<PriceRangeSearchResponse>{}(res);
       }
 
       PriceRangeSearchResponse res;
+      auto fares = flights.FareSlots();
+      auto [first, last] = flights.FareRange(req.from, req.to);
+      auto page = SelectPage(first, last, req.cursor, req.page_size);
       std::vector<srpc::i32> results;
-      for (const auto &flight : flights) {
-        if (flight.second.airfare >= req.from &&
-            flight.second.airfare <= req.to) {
-          results.emplace_back(flight.second.identifier);
-        }
+      results.reserve(page.end - page.begin);
+      for (auto i = page.begin; i < page.end; ++i) {
+        results.push_back(flights.Schedule(fares[i]).identifier);
       }
-      std::sort(results.begin(), results.end(), std::less<srpc::i32>{});
       if (results.empty()) {
         res.id = req.id;
         res.status_code = 1;
         res.message = "Flights not found";
-        res.flights = std::move(results);
+        res.flights = MakeIdList(req.encoding, std::move(results));
+        res.next_cursor = 0;
       } else {
         res.id = req.id;
         res.status_code = 0;
         res.message = {};
-        res.flights = std::move(results);
+        res.flights = MakeIdList(req.encoding, std::move(results));
+        res.next_cursor = page.next_cursor;
       }
       if (semantic == InvocationSemantic::kAtMostOnce) {
         history[req.id] = {req, res};
@@ -565,7 +1028,7 @@ std::optional<std::vector<std::byte>> Serve(
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
 
       std::clog << "Info: Sending price range search response to " << from_addr
                 << ": " << res << std::endl;
@@ -586,14 +1049,17 @@ std::optional<std::vector<std::byte>> Serve(
       std::clog << "Info: Received seat reservation cancellation request from "
                 << from_addr << ": " << req << std::endl;
 
-      auto req_lost = RandomLoss(0.1);
-      auto res_lost = RandomLoss(0.2);
+      auto req_lost = simulation.Loss(0.1);
+      auto res_lost = simulation.Loss(0.2);
       if (req_lost) {
         std::clog << "Info: Request " << req.id << " is simulated to be lost"
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
+      if (Expired(deadline, req.id)) {
+        return {};
+      }
 
       if (semantic == InvocationSemantic::kAtMostOnce &&
           history.contains(req.id)) {
@@ -605,7 +1071,7 @@ std::optional<std::vector<std::byte>> Serve(
                     << std::endl;
           return {};
         }
-        RandomDelay();
+        simulation.Delay();
         std::clog << "Info: Returning saved response " << res << std::endl;
         return srpc::Marshal<SeatReservationCancellationResponse>{}(res);
       }
@@ -627,7 +1093,6 @@ std::optional<std::vector<std::byte>> Serve(
           res.identifier = 0;
           res.seats = 0;
         } else {
-          auto &flight = flights[req.identifier];
           if (req.seats > reservation.seats) {
             res.id = req.id;
             res.status_code = 3;
@@ -640,32 +1105,15 @@ std::optional<std::vector<std::byte>> Serve(
             std::clog << "Info: Reservation " << req.reservation_req_id
                       << " now has " << reservation.seats << " seat(s) left"
                       << std::endl;
-            flight.seat_availability += req.seats;
-            std::clog << "Info: Flight " << flight.identifier << " now has "
-                      << flight.seat_availability << " seat(s) left"
-                      << std::endl;
+            auto seats_left = flights.Release(reservation.slot, req.seats);
+            std::clog << "Info: Flight " << req.identifier << " now has "
+                      << seats_left << " seat(s) left" << std::endl;
             res.status_code = 0;
             res.message = {};
             res.identifier = req.identifier;
             res.seats = req.seats;
-            // Note: for simplicity, expired callbacks are not handled.
-            auto now = std::chrono::system_clock::now();
-            SeatAvailabilityCallbackRequest cb_req{
-                .identifier = flight.identifier,
-                .seat_availability = flight.seat_availability,
-            };
-            for (const auto &callback : callbacks[req.identifier]) {
-              if (now < callback.monitor_end) {
-                std::clog << "Info: Sending callback " << cb_req << " to "
-                          << callback.to_addr << std::endl;
-                std::thread{SendSeatAvailabilityCallbackRequest,
-                            callback.to_addr, cb_req}
-                    .detach();
-              } else {
-                std::clog << "Info: Callback to " << callback.to_addr
-                          << " is expired" << std::endl;
-              }
-            }
+            NotifySubscribers(notifier, dispatcher, multicast,
+                              flights.Schedule(reservation.slot), seats_left);
           }
         }
       }
@@ -678,7 +1126,7 @@ std::optional<std::vector<std::byte>> Serve(
                   << std::endl;
         return {};
       }
-      RandomDelay();
+      simulation.Delay();
 
       std::clog << "Info: Sending seat reservation cancellation response to "
                 << from_addr << ": " << res << std::endl;
@@ -694,9 +1142,10 @@ std::optional<std::vector<std::byte>> Serve(
 }  // namespace
 
 int main(int argc, char **argv) {
-  if (argc != 4) {
+  if (argc < 4 || argc > 6) {
     std::cerr << "Usage: " << argv[0]
               << " (at-least-once | at-most-once) <port> <flights-input>"
+                 " [<multicast-port> [<multicast-interface>]]"
               << std::endl;
     // NOLINTNEXTLINE(concurrency-mt-unsafe)
     std::exit(EXIT_FAILURE);
@@ -717,18 +1166,106 @@ int main(int argc, char **argv) {
     std::exit(EXIT_FAILURE);
   }
 
-  auto flights = ReadFlightsFromFile(flights_input);
+  FlightStore flights{ReadFlightsFromFile(flights_input)};
+  std::string sender_error;
+  auto sender = CallbackSender::New(&sender_error);
+  if (sender == nullptr) {
+    std::cerr << "Error: Unable to create callback sender: " << sender_error
+              << std::endl;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    std::exit(EXIT_FAILURE);
+  }
+  CallbackDispatcher dispatcher{
+      kCallbackWorkers, kCallbackQueueCapacity,
+      [&sender](const srpc::SocketAddress &to_addr,
+                SeatAvailabilityCallbackRequest req) {
+        SendSeatAvailabilityCallbackRequest(*sender, to_addr, req);
+      }};
+  Notifier notifier{dispatcher};
+
+  std::unique_ptr<MulticastPublisher> multicast;
+  if (argc >= 5) {
+    auto multicast_port = static_cast<srpc::u16>(std::atoi(argv[4]));
+    std::string multicast_interface = argc >= 6 ? argv[5] : "0.0.0.0";
+    std::string multicast_error;
+    multicast = MulticastPublisher::New(multicast_port, multicast_interface,
+                                        &multicast_error);
+    if (multicast == nullptr) {
+      std::cerr << "Error: Unable to create multicast publisher: "
+                << multicast_error << std::endl;
+      // NOLINTNEXTLINE(concurrency-mt-unsafe)
+      std::exit(EXIT_FAILURE);
+    }
+    std::clog << "Info: Multicasting to port " << multicast_port << " via "
+              << multicast_interface << std::endl;
+  }
+
+  std::string socket_error;
+  auto socket =
+      DatagramSocket::New(static_cast<srpc::u16>(port), &socket_error);
+  if (socket == nullptr) {
+    std::cerr << "Error: Unable to create socket: " << socket_error
+              << std::endl;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    std::exit(EXIT_FAILURE);
+  }
 
-  auto server_res = srpc::DatagramServer::New(port);
-  if (!server_res.OK()) {
-    std::cerr << server_res.Error() << std::endl;
+  std::string loop_error;
+  auto loop = EventLoop::New(&loop_error);
+  if (loop == nullptr) {
+    std::cerr << "Error: Unable to create event loop: " << loop_error
+              << std::endl;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    std::exit(EXIT_FAILURE);
+  }
+
+  SentFragments sent{kSentFragmentsCapacity};
+  // Serves every request waiting at the socket.
+  auto serve_requests = [&] {
+    for (;;) {
+      std::string error;
+      auto datagram =
+          socket->ReceiveFrom(std::chrono::milliseconds{0}, &error);
+      if (!datagram.has_value()) {
+        if (!error.empty()) {
+          std::cerr << "Error: Could not receive request: " << error
+                    << std::endl;
+        }
+        return;
+      }
+      auto retransmit_res =
+          srpc::Unmarshal<FragmentRetransmitRequest>{}(datagram->data);
+      if (retransmit_res.second.has_value()) {
+        RetransmitFragments(*socket, sent, datagram->from_addr,
+                            *retransmit_res.second);
+        continue;
+      }
+      std::span<const std::byte> req_data = datagram->data;
+      auto deadline = Deadline::max();
+      auto timed_res = srpc::Unmarshal<TimedRequest>{}(req_data);
+      if (timed_res.second.has_value()) {
+        // Counted from arrival at the host, so that time spent queued behind
+        // other requests counts against the budget.
+        deadline = datagram->received_at +
+                   std::chrono::milliseconds{timed_res.second->time_budget_ms};
+        req_data = timed_res.second->request;
+      }
+      Simulation simulation{true};
+      auto res_data =
+          Serve(semantic, flights, notifier, dispatcher, multicast.get(),
+                datagram->from_addr, req_data, simulation, deadline);
+      if (res_data.has_value()) {
+        SendResponse(*socket, sent, datagram->from_addr, *res_data,
+                     simulation);
+      }
+    }
+  };
+  if (!loop->Watch(socket->Fd(), serve_requests, &loop_error)) {
+    std::cerr << "Error: " << loop_error << std::endl;
     // NOLINTNEXTLINE(concurrency-mt-unsafe)
     std::exit(EXIT_FAILURE);
   }
 
-  auto server = std::move(server_res.Value());
   std::clog << "Info: Server listening at port " << port << std::endl;
-  server->Listen([semantic, flights](const auto &from_addr, auto req_data_res) {
-    return Serve(semantic, flights, from_addr, req_data_res);
-  });
+  loop->Run();
 }
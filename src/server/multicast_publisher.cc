@@ -0,0 +1,83 @@
+#include "server/multicast_publisher.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/codec.h"
+#include "messages/seat_availability.h"
+#include "messages/wire.h"
+#include "network/datagram_socket.h"
+#include "utils/rand.h"
+
+namespace dfis {
+
+std::unique_ptr<MulticastPublisher> MulticastPublisher::New(
+    srpc::u16 port, const std::string &interface_addr, std::string *error) {
+  auto socket = DatagramSocket::New(0, error);
+  if (socket == nullptr ||
+      !socket->SetMulticastInterface(interface_addr, error)) {
+    return nullptr;
+  }
+  return std::unique_ptr<MulticastPublisher>{
+      new MulticastPublisher{std::move(socket), port}};
+}
+
+std::string MulticastPublisher::Group(srpc::i32 identifier) {
+  return "239.255.77." +
+         std::to_string(static_cast<srpc::u32>(identifier) % kMulticastGroups);
+}
+
+MulticastPublisher::MulticastPublisher(std::unique_ptr<DatagramSocket> socket,
+                                       srpc::u16 port)
+    : socket_(std::move(socket)), port_(port) {}
+
+void MulticastPublisher::Enable(srpc::i32 identifier,
+                                Clock::time_point monitor_end) {
+  std::lock_guard lock{mutex_};
+  auto &channel = channels_[identifier];
+  channel.monitor_end = std::max(channel.monitor_end, monitor_end);
+}
+
+bool MulticastPublisher::Publish(srpc::i32 identifier,
+                                 srpc::i32 seat_availability,
+                                 std::string *error) {
+  std::lock_guard lock{mutex_};
+  auto it = channels_.find(identifier);
+  if (it == channels_.end()) {
+    return false;
+  }
+  if (Clock::now() >= it->second.monitor_end) {
+    channels_.erase(it);
+    return false;
+  }
+  // Sent under the lock, so that updates leave in sequence order.
+  SeatAvailabilityCallbackRequest req{
+      .id = MakeMessageIdentifier(),
+      .subscription = 0,
+      .identifier = identifier,
+      .sequence = ++it->second.sequence,
+      .seat_availability = seat_availability,
+  };
+  srpc::SocketAddress to_addr{
+      .protocol = srpc::kIPv4,
+      .address = Group(identifier),
+      .port = port_,
+  };
+  std::array<std::byte, kSerializedSize<SeatAvailabilityCallbackRequest>>
+      buffer;
+  ByteWriter writer{std::span<std::byte>{buffer}};
+  srpc::Marshal<SeatAvailabilityCallbackRequest>{}(req, writer);
+  return socket_->SendTo(to_addr, buffer, error);
+}
+
+}  // namespace dfis
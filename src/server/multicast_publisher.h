@@ -0,0 +1,59 @@
+#ifndef DFIS_SERVER_MULTICAST_PUBLISHER_H_
+#define DFIS_SERVER_MULTICAST_PUBLISHER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <srpc/types/integers.h>
+
+#include "network/datagram_socket.h"
+
+namespace dfis {
+
+inline constexpr std::size_t kMulticastGroups = 256;
+
+// Sends the seat availability updates of flights monitored via multicast, once
+// per update however many clients listen. Flights are spread over
+// kMulticastGroups groups in 239.255.77.0/24, which is organisation-local.
+// Safe to use from multiple threads.
+class MulticastPublisher {
+ public:
+  using Clock = std::chrono::system_clock;
+
+  // Sends to the given port through the interface with the given address.
+  [[nodiscard]] static std::unique_ptr<MulticastPublisher> New(
+      srpc::u16 port, const std::string &interface_addr,
+      std::string *error = nullptr);
+
+  [[nodiscard]] static std::string Group(srpc::i32 identifier);
+
+  [[nodiscard]] srpc::u16 Port() const { return port_; }
+
+  // Multicasts updates to the flight until at least monitor_end.
+  void Enable(srpc::i32 identifier, Clock::time_point monitor_end);
+
+  // Sends the update if the flight is monitored, and returns whether it was.
+  bool Publish(srpc::i32 identifier, srpc::i32 seat_availability,
+               std::string *error = nullptr);
+
+ private:
+  struct Channel {
+    Clock::time_point monitor_end;
+    srpc::u64 sequence;
+  };
+
+  MulticastPublisher(std::unique_ptr<DatagramSocket> socket, srpc::u16 port);
+
+  std::unique_ptr<DatagramSocket> socket_;
+  srpc::u16 port_;
+  std::mutex mutex_;
+  std::unordered_map<srpc::i32, Channel> channels_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_MULTICAST_PUBLISHER_H_
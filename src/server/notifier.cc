@@ -0,0 +1,210 @@
+#include "server/notifier.h"
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <utility>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+#include "messages/seat_availability.h"
+#include "server/callback_dispatcher.h"
+#include "server/flight_store.h"
+#include "server/subscriptions.h"
+
+namespace dfis {
+
+namespace {
+
+constexpr std::chrono::milliseconds kTick{10};
+
+// Evaluates the subscription's trigger against a new availability, and
+// records the resulting condition.
+bool Triggers(const SubscriptionOptions &options, SubscriptionState &state,
+              srpc::i32 seat_availability) {
+  auto was_below = state.below;
+  auto below = seat_availability < options.threshold;
+  state.below = below;
+  switch (options.trigger) {
+    case SeatAvailabilityTrigger::kEveryChange: return true;
+    case SeatAvailabilityTrigger::kFallsBelow: return !was_below && below;
+    case SeatAvailabilityTrigger::kRisesTo: return was_below && !below;
+    case SeatAvailabilityTrigger::kCrosses: return was_below != below;
+  }
+  return false;
+}
+
+}  // namespace
+
+std::ostream &operator<<(std::ostream &os, const PublishResult &result) {
+  os << result.sent << " sent, " << result.filtered << " filtered, "
+     << result.coalesced << " coalesced, " << result.dropped << " dropped";
+  return os;
+}
+
+Notifier::Notifier(CallbackDispatcher &dispatcher)
+    : dispatcher_(dispatcher),
+      subscriptions_(Clock::now()),
+      flushes_(kTick, Clock::now()),
+      ticker_([this] { Tick(); }) {}
+
+Notifier::~Notifier() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  ticker_.join();
+}
+
+srpc::u64 Notifier::Subscribe(srpc::i32 identifier,
+                              const srpc::SocketAddress &to_addr,
+                              Clock::time_point monitor_end,
+                              const SubscriptionOptions &options,
+                              srpc::i32 seat_availability) {
+  std::lock_guard lock{mutex_};
+  return subscriptions_.Add(Subscription{
+      .id = 0,
+      .topic = identifier,
+      .to_addr = to_addr,
+      .monitor_end = monitor_end,
+      .options = options,
+      .flights = {{identifier,
+                   SubscriptionState{
+                       .below = seat_availability < options.threshold,
+                       .sequence = 0,
+                       .seat_availability = seat_availability,
+                       .last_sent = {},
+                       .pending = {},
+                       .pending_from_below = false,
+                   }}},
+  });
+}
+
+srpc::u64 Notifier::Subscribe(
+    const RouteFilter &filter, const srpc::SocketAddress &to_addr,
+    Clock::time_point monitor_end, const SubscriptionOptions &options,
+    std::span<const std::pair<srpc::i32, srpc::i32>> seat_availability) {
+  Subscription subscription{
+      .id = 0,
+      .topic = filter,
+      .to_addr = to_addr,
+      .monitor_end = monitor_end,
+      .options = options,
+      .flights = {},
+  };
+  for (const auto &[identifier, seats] : seat_availability) {
+    subscription.flights.emplace(identifier,
+                                 SubscriptionState{
+                                     .below = seats < options.threshold,
+                                     .sequence = 0,
+                                     .seat_availability = seats,
+                                     .last_sent = {},
+                                     .pending = {},
+                                     .pending_from_below = false,
+                                 });
+  }
+  std::lock_guard lock{mutex_};
+  return subscriptions_.Add(std::move(subscription));
+}
+
+PublishResult Notifier::Publish(const FlightSchedule &schedule,
+                                srpc::i32 seat_availability) {
+  PublishResult result{};
+  auto now = Clock::now();
+  auto identifier = schedule.identifier;
+  std::lock_guard lock{mutex_};
+  subscriptions_.Expire(now);
+  subscriptions_.ForEach(schedule, [&](Subscription &subscription) {
+    auto &state = subscription.flights[identifier];
+    auto was_below = state.below;
+    auto triggered = Triggers(subscription.options, state, seat_availability);
+    if (state.pending.has_value()) {
+      // A flush is already scheduled. It carries the latest availability,
+      // unless the change that fired the trigger has since been undone.
+      if (subscription.options.trigger !=
+              SeatAvailabilityTrigger::kEveryChange &&
+          state.below == state.pending_from_below) {
+        state.pending.reset();
+        ++result.filtered;
+      } else {
+        state.pending = seat_availability;
+        ++result.coalesced;
+      }
+    } else if (!triggered) {
+      ++result.filtered;
+    } else if (now < state.last_sent + subscription.options.coalesce_window) {
+      state.pending = seat_availability;
+      state.pending_from_below = was_below;
+      flushes_.Schedule(state.last_sent + subscription.options.coalesce_window,
+                        Flush{subscription.id, identifier});
+      ++result.coalesced;
+    } else if (Send(subscription, identifier, state, seat_availability, now)) {
+      ++result.sent;
+    } else {
+      ++result.dropped;
+    }
+  });
+  return result;
+}
+
+bool Notifier::Send(const Subscription &subscription, srpc::i32 identifier,
+                    SubscriptionState &state, srpc::i32 seat_availability,
+                    Clock::time_point now) {
+  state.last_sent = now;
+  // The sequence number advances even if the dispatcher drops the update, so
+  // that the subscriber sees the gap.
+  ++state.sequence;
+  state.seat_availability = seat_availability;
+  return dispatcher_.Dispatch(subscription.to_addr,
+                              SeatAvailabilityCallbackRequest{
+                                  .id = 0,
+                                  .subscription = subscription.id,
+                                  .identifier = identifier,
+                                  .sequence = state.sequence,
+                                  .seat_availability = seat_availability,
+                              });
+}
+
+std::optional<SubscriptionState> Notifier::Snapshot(srpc::u64 subscription,
+                                                    srpc::i32 identifier) {
+  std::lock_guard lock{mutex_};
+  const auto *found = subscriptions_.Find(subscription);
+  if (found == nullptr) {
+    return {};
+  }
+  auto it = found->flights.find(identifier);
+  if (it == found->flights.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+void Notifier::Tick() {
+  std::unique_lock lock{mutex_};
+  while (!stopping_) {
+    cv_.wait_for(lock, kTick);
+    auto now = Clock::now();
+    subscriptions_.Expire(now);
+    flushes_.Advance(now, [this, now](const Flush &flush) {
+      auto *subscription = subscriptions_.Find(flush.id);
+      if (subscription == nullptr) {
+        return;
+      }
+      auto it = subscription->flights.find(flush.identifier);
+      if (it == subscription->flights.end() ||
+          !it->second.pending.has_value()) {
+        return;
+      }
+      auto seat_availability = *it->second.pending;
+      it->second.pending.reset();
+      Send(*subscription, flush.identifier, it->second, seat_availability,
+           now);
+    });
+  }
+}
+
+}  // namespace dfis
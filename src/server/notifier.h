@@ -0,0 +1,95 @@
+#ifndef DFIS_SERVER_NOTIFIER_H_
+#define DFIS_SERVER_NOTIFIER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+#include "server/callback_dispatcher.h"
+#include "server/flight_store.h"
+#include "server/subscriptions.h"
+#include "server/timer_wheel.h"
+
+namespace dfis {
+
+struct PublishResult {
+  std::size_t sent;
+  std::size_t filtered;
+  std::size_t coalesced;
+  std::size_t dropped;
+};
+
+std::ostream &operator<<(std::ostream &os, const PublishResult &result);
+
+// Fans seat availability changes out to subscribers through the dispatcher, as
+// one-way updates numbered per subscription and flight.
+// Changes that do not fire a subscriber's trigger are filtered out. A
+// subscriber with a coalescing window receives at most one callback per window;
+// an update arriving within it is held back, and sent when the window closes
+// with the latest availability, or dropped if the change that fired the
+// trigger has been undone by then. A background thread expires subscriptions
+// and flushes held-back updates. Safe to use from multiple threads.
+class Notifier {
+ public:
+  using Clock = std::chrono::system_clock;
+
+  explicit Notifier(CallbackDispatcher &dispatcher);
+  Notifier(const Notifier &) = delete;
+  Notifier &operator=(const Notifier &) = delete;
+  ~Notifier();
+
+  // Subscribes to a flight whose availability is currently
+  // seat_availability; edge triggers are evaluated relative to it.
+  srpc::u64 Subscribe(srpc::i32 identifier, const srpc::SocketAddress &to_addr,
+                      Clock::time_point monitor_end,
+                      const SubscriptionOptions &options,
+                      srpc::i32 seat_availability);
+
+  // Subscribes to every flight matching the filter, given as pairs of flight
+  // identifier and current availability.
+  srpc::u64 Subscribe(
+      const RouteFilter &filter, const srpc::SocketAddress &to_addr,
+      Clock::time_point monitor_end, const SubscriptionOptions &options,
+      std::span<const std::pair<srpc::i32, srpc::i32>> seat_availability);
+
+  PublishResult Publish(const FlightSchedule &schedule,
+                        srpc::i32 seat_availability);
+
+  // Returns the delivery state of a flight within a live subscription, so that
+  // a subscriber that missed updates can resynchronise.
+  [[nodiscard]] std::optional<SubscriptionState> Snapshot(
+      srpc::u64 subscription, srpc::i32 identifier);
+
+ private:
+  struct Flush {
+    srpc::u64 id;
+    srpc::i32 identifier;
+  };
+
+  bool Send(const Subscription &subscription, srpc::i32 identifier,
+            SubscriptionState &state, srpc::i32 seat_availability,
+            Clock::time_point now);
+
+  void Tick();
+
+  CallbackDispatcher &dispatcher_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+  SubscriptionTable subscriptions_;
+  TimerWheel<Flush> flushes_;
+  std::thread ticker_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_NOTIFIER_H_
@@ -0,0 +1,25 @@
+#include "server/pagination.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+Page SelectPage(std::size_t first, std::size_t last, srpc::u64 cursor,
+                srpc::u32 page_size) {
+  auto begin = static_cast<std::size_t>(
+      std::clamp<srpc::u64>(cursor, first, std::max(first, last)));
+  auto end = std::max(begin, last);
+  if (page_size != 0) {
+    end = std::min(end, begin + page_size);
+  }
+  return Page{
+      .begin = begin,
+      .end = end,
+      .next_cursor = end < last ? end : 0,
+  };
+}
+
+}  // namespace dfis
@@ -0,0 +1,31 @@
+#ifndef DFIS_SERVER_PAGINATION_H_
+#define DFIS_SERVER_PAGINATION_H_
+
+#include <cstddef>
+
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+// A page of results, as positions [begin, end) in a sorted index.
+struct Page {
+  std::size_t begin;
+  std::size_t end;
+  // The cursor of the next page, or 0 if there is none.
+  srpc::u64 next_cursor;
+};
+
+// Selects the page starting at the cursor from the results at positions
+// [first, last) of an index that never changes, holding at most page_size
+// results (or all of them if page_size is 0).
+//
+// A cursor is the position the page starts at, so resuming from it is a jump
+// into the index rather than a repeat of the search. Only a first page can
+// start at position 0, leaving cursor 0 free to stand for the first page.
+// Cursors outside [first, last) are clamped to it.
+[[nodiscard]] Page SelectPage(std::size_t first, std::size_t last,
+                              srpc::u64 cursor, srpc::u32 page_size);
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_PAGINATION_H_
@@ -0,0 +1,90 @@
+#include "server/subscriptions.h"
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <srpc/types/integers.h>
+
+#include "server/flight_store.h"
+
+namespace dfis {
+
+namespace {
+
+constexpr std::chrono::milliseconds kExpiryTick{100};
+
+}  // namespace
+
+bool RouteFilter::Matches(const FlightSchedule &schedule) const {
+  return schedule.source == route.source &&
+         schedule.destination == route.destination &&
+         schedule.departure_time >= departure_from &&
+         (departure_to == 0 || schedule.departure_time <= departure_to);
+}
+
+SubscriptionTable::SubscriptionTable(Clock::time_point now)
+    : expiries_(kExpiryTick, now) {}
+
+srpc::u64 SubscriptionTable::Add(Subscription subscription) {
+  auto id = next_id_++;
+  subscription.id = id;
+  auto &subscriptions =
+      std::holds_alternative<srpc::i32>(subscription.topic)
+          ? by_flight_[std::get<srpc::i32>(subscription.topic)]
+          : by_route_[std::get<RouteFilter>(subscription.topic).route];
+  positions_.emplace(id, Position{
+                             .list = &subscriptions,
+                             .index = subscriptions.size(),
+                         });
+  expiries_.Schedule(subscription.monitor_end, id);
+  subscriptions.push_back(std::move(subscription));
+  return id;
+}
+
+Subscription *SubscriptionTable::Find(srpc::u64 id) {
+  auto it = positions_.find(id);
+  if (it == positions_.end()) {
+    return nullptr;
+  }
+  return &(*it->second.list)[it->second.index];
+}
+
+std::size_t SubscriptionTable::Expire(Clock::time_point now) {
+  std::size_t removed = 0;
+  expiries_.Advance(now, [this, &removed](srpc::u64 id) {
+    Remove(id);
+    ++removed;
+  });
+  return removed;
+}
+
+void SubscriptionTable::Remove(srpc::u64 id) {
+  auto it = positions_.find(id);
+  if (it == positions_.end()) {
+    return;
+  }
+  auto position = it->second;
+  positions_.erase(it);
+
+  auto &subscriptions = *position.list;
+  if (position.index + 1 != subscriptions.size()) {
+    std::swap(subscriptions[position.index], subscriptions.back());
+    positions_[subscriptions[position.index].id].index = position.index;
+  }
+  if (subscriptions.size() > 1) {
+    subscriptions.pop_back();
+    return;
+  }
+  // The key lives inside the list about to be erased, so take it out first.
+  auto topic = std::move(subscriptions.back().topic);
+  if (std::holds_alternative<srpc::i32>(topic)) {
+    by_flight_.erase(std::get<srpc::i32>(topic));
+  } else {
+    by_route_.erase(std::get<RouteFilter>(topic).route);
+  }
+}
+
+}  // namespace dfis
@@ -0,0 +1,125 @@
+#ifndef DFIS_SERVER_SUBSCRIPTIONS_H_
+#define DFIS_SERVER_SUBSCRIPTIONS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+#include "messages/seat_availability.h"
+#include "server/flight_store.h"
+#include "server/timer_wheel.h"
+
+namespace dfis {
+
+struct SubscriptionOptions {
+  // Updates within this window after a callback are coalesced into one.
+  std::chrono::milliseconds coalesce_window;
+  SeatAvailabilityTrigger trigger;
+  srpc::i32 threshold;
+};
+
+// Every flight on a route departing within [departure_from, departure_to]. A
+// departure_to of 0 leaves the window open-ended.
+struct RouteFilter {
+  Route route;
+  srpc::i64 departure_from;
+  srpc::i64 departure_to;
+
+  [[nodiscard]] bool Matches(const FlightSchedule &schedule) const;
+};
+
+// Delivery state of one flight within a subscription.
+struct SubscriptionState {
+  // Whether availability was below the threshold at the last update.
+  bool below;
+  // The sequence number of the last update sent, and the availability it
+  // carried (or the availability at subscription, before any is sent).
+  srpc::u64 sequence;
+  srpc::i32 seat_availability;
+  std::chrono::system_clock::time_point last_sent;
+  // The latest update held back by coalescing, if any.
+  std::optional<srpc::i32> pending;
+  // Whether availability was below the threshold before the held-back update
+  // fired the trigger; returning there undoes it.
+  bool pending_from_below;
+};
+
+struct Subscription {
+  srpc::u64 id;
+  // Either a single flight identifier, or a route.
+  std::variant<srpc::i32, RouteFilter> topic;
+  srpc::SocketAddress to_addr;
+  std::chrono::system_clock::time_point monitor_end;
+  SubscriptionOptions options;
+  // Keyed by flight identifier.
+  std::unordered_map<srpc::i32, SubscriptionState> flights;
+};
+
+// Live seat availability subscriptions, grouped by flight or by route. A route
+// subscription is a single record however many flights it covers.
+// Subscriptions are dropped by a timer wheel as soon as their monitoring
+// interval ends, so the cost of a fan-out only depends on the subscribers still
+// monitoring. Not thread-safe.
+class SubscriptionTable {
+ public:
+  using Clock = std::chrono::system_clock;
+
+  explicit SubscriptionTable(Clock::time_point now);
+
+  // Adds the subscription, and returns the identifier assigned to it.
+  srpc::u64 Add(Subscription subscription);
+
+  [[nodiscard]] Subscription *Find(srpc::u64 id);
+
+  // Removes all subscriptions whose monitoring interval has ended by now, and
+  // returns the number removed.
+  std::size_t Expire(Clock::time_point now);
+
+  // Calls fn on each subscription to the flight itself, and on each route
+  // subscription that covers it.
+  template <typename F>
+  void ForEach(const FlightSchedule &schedule, F &&fn) {
+    if (auto it = by_flight_.find(schedule.identifier);
+        it != by_flight_.end()) {
+      for (auto &subscription : it->second) {
+        fn(subscription);
+      }
+    }
+    if (auto it = by_route_.find(Route{schedule.source, schedule.destination});
+        it != by_route_.end()) {
+      for (auto &subscription : it->second) {
+        if (std::get<RouteFilter>(subscription.topic).Matches(schedule)) {
+          fn(subscription);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t Size() const { return positions_.size(); }
+
+ private:
+  struct Position {
+    // Elements of unordered_map are never relocated, and a list is only erased
+    // once it is empty.
+    std::vector<Subscription> *list;
+    std::size_t index;
+  };
+
+  void Remove(srpc::u64 id);
+
+  srpc::u64 next_id_ = 1;
+  std::unordered_map<srpc::i32, std::vector<Subscription>> by_flight_;
+  std::unordered_map<Route, std::vector<Subscription>, RouteHash> by_route_;
+  std::unordered_map<srpc::u64, Position> positions_;
+  TimerWheel<srpc::u64> expiries_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_SUBSCRIPTIONS_H_
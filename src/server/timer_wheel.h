@@ -0,0 +1,140 @@
+#ifndef DFIS_SERVER_TIMER_WHEEL_H_
+#define DFIS_SERVER_TIMER_WHEEL_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <srpc/types/integers.h>
+
+namespace dfis {
+
+// A hierarchical timing wheel. Level n has kSlots slots, each spanning
+// kSlots^n ticks; a timer is placed in the lowest level that can reach its
+// expiry, and moves down a level each time its slot comes round. Scheduling is
+// O(1), and each timer is touched at most kLevels times before it expires.
+//
+// Timers never fire early; they may fire up to one tick late. Not thread-safe.
+template <typename T>
+class TimerWheel {
+ public:
+  using Clock = std::chrono::system_clock;
+
+  TimerWheel(Clock::duration tick, Clock::time_point now)
+      : tick_(tick), origin_(now) {}
+
+  void Schedule(Clock::time_point when, T value) {
+    srpc::u64 expiry = 0;
+    if (when > origin_) {
+      // Round up, so that the timer does not fire before it is due.
+      expiry = static_cast<srpc::u64>(
+          (when - origin_ + tick_ - Clock::duration{1}) / tick_);
+    }
+    Insert(Entry{
+        .expiry = std::max(expiry, current_),
+        .value = std::move(value),
+    });
+    ++size_;
+  }
+
+  // Advances the wheel to now, calling fn on each timer that has expired.
+  template <typename F>
+  void Advance(Clock::time_point now, F &&fn) {
+    if (now < origin_) {
+      return;
+    }
+    auto target = static_cast<srpc::u64>((now - origin_) / tick_);
+    while (current_ <= target) {
+      for (std::size_t level = kLevels - 1; level > 0; --level) {
+        if ((current_ & ((srpc::u64{1} << (kBits * level)) - 1)) == 0) {
+          Cascade(level);
+        }
+      }
+      auto &slot = wheels_[0][current_ & kMask];
+      auto expired = std::move(slot);
+      slot.clear();
+      counts_[0] -= expired.size();
+      size_ -= expired.size();
+      for (auto &entry : expired) {
+        fn(std::move(entry.value));
+      }
+      ++current_;
+      Skip(target + 1);
+    }
+  }
+
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+ private:
+  static constexpr std::size_t kBits = 6;
+  static constexpr std::size_t kSlots = std::size_t{1} << kBits;
+  static constexpr srpc::u64 kMask = kSlots - 1;
+  static constexpr std::size_t kLevels = 4;
+
+  struct Entry {
+    srpc::u64 expiry;
+    T value;
+  };
+
+  void Insert(Entry entry) {
+    for (std::size_t level = 0; level < kLevels; ++level) {
+      auto shift = kBits * level;
+      if ((entry.expiry >> shift) - (current_ >> shift) < kSlots) {
+        wheels_[level][(entry.expiry >> shift) & kMask].push_back(
+            std::move(entry));
+        ++counts_[level];
+        return;
+      }
+    }
+    // Beyond the range of the wheel; park it in the farthest slot of the top
+    // level, to be placed again when that slot comes round.
+    auto shift = kBits * (kLevels - 1);
+    wheels_[kLevels - 1][((current_ >> shift) + kMask) & kMask].push_back(
+        std::move(entry));
+    ++counts_[kLevels - 1];
+  }
+
+  void Cascade(std::size_t level) {
+    auto &slot = wheels_[level][(current_ >> (kBits * level)) & kMask];
+    auto entries = std::move(slot);
+    slot.clear();
+    counts_[level] -= entries.size();
+    for (auto &entry : entries) {
+      Insert(std::move(entry));
+    }
+  }
+
+  // Jumps over ticks on which nothing can happen: if the lowest levels are
+  // empty, the next event is at the next slot boundary of the first non-empty
+  // one.
+  void Skip(srpc::u64 limit) {
+    std::size_t level = 0;
+    while (level < kLevels && counts_[level] == 0) {
+      ++level;
+    }
+    if (level == 0) {
+      return;
+    }
+    if (level == kLevels) {
+      current_ = std::max(current_, limit);
+      return;
+    }
+    auto span = srpc::u64{1} << (kBits * level);
+    auto boundary = (current_ + span - 1) & ~(span - 1);
+    current_ = std::max(current_, std::min(boundary, limit));
+  }
+
+  Clock::duration tick_;
+  Clock::time_point origin_;
+  srpc::u64 current_ = 0;
+  std::size_t size_ = 0;
+  std::array<std::size_t, kLevels> counts_{};
+  std::array<std::array<std::vector<Entry>, kSlots>, kLevels> wheels_;
+};
+
+}  // namespace dfis
+
+#endif  // DFIS_SERVER_TIMER_WHEEL_H_
@@ -0,0 +1,167 @@
+#ifndef DFIS_UTILS_TASK_H_
+#define DFIS_UTILS_TASK_H_
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+// A minimal coroutine type. A Task starts when awaited, and resumes its awaiter
+// when it finishes. Exceptions are not used in this project, so one escaping a
+// task terminates the program.
+
+namespace dfis {
+
+template <typename T = void>
+class Task;
+
+namespace task_internal {
+
+// Resumes whatever awaits the finished task, if anything.
+struct FinalAwaiter {
+  [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<Promise> handle) noexcept {
+    auto continuation = handle.promise().Continuation();
+    return continuation ? continuation : std::noop_coroutine();
+  }
+
+  void await_resume() const noexcept {}
+};
+
+class PromiseBase {
+ public:
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  FinalAwaiter final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() noexcept { std::terminate(); }
+
+  // The coroutine to resume once the task finishes.
+  [[nodiscard]] std::coroutine_handle<> Continuation() const {
+    return continuation_;
+  }
+
+  void SetContinuation(std::coroutine_handle<> continuation) {
+    continuation_ = continuation;
+  }
+
+ private:
+  std::coroutine_handle<> continuation_;
+};
+
+template <typename T>
+class Promise : public PromiseBase {
+ public:
+  Task<T> get_return_object();
+
+  template <typename U>
+  void return_value(U &&value) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T TakeValue() { return std::move(*value_); }
+
+ private:
+  std::optional<T> value_;
+};
+
+template <>
+class Promise<void> : public PromiseBase {
+ public:
+  Task<void> get_return_object();
+
+  void return_void() {}
+
+  void TakeValue() {}
+};
+
+}  // namespace task_internal
+
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = task_internal::Promise<T>;
+
+  Task(Task &&other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  // Starts the task, and resumes the awaiting coroutine with its result.
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> handle;
+
+      [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().SetContinuation(awaiting);
+        return handle;
+      }
+
+      T await_resume() { return handle.promise().TakeValue(); }
+    };
+    return Awaiter{handle_};
+  }
+
+ private:
+  friend promise_type;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace task_internal {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() {
+  return Task<T>{std::coroutine_handle<Promise<T>>::from_promise(*this)};
+}
+
+inline Task<void> Promise<void>::get_return_object() {
+  return Task<void>{std::coroutine_handle<Promise<void>>::from_promise(*this)};
+}
+
+// Runs a task to completion on its own, and then frees it.
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+}  // namespace task_internal
+
+// Starts a task that nothing awaits. It runs on the calling thread until it
+// first suspends.
+inline void Spawn(Task<void> task) {
+  [](Task<void> task) -> task_internal::Detached {
+    co_await std::move(task);
+  }(std::move(task));
+}
+
+}  // namespace dfis
+
+#endif  // DFIS_UTILS_TASK_H_
@@ -0,0 +1,61 @@
+#include "client/callback_listener.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/seat_availability.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+
+using namespace dfis;
+
+TEST(Client, CallbackListenerSharesSocket) {
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  std::vector<srpc::u64> subscriptions;
+  auto listener = CallbackListener::New(
+      *loop, 0, [&](const SeatAvailabilityCallbackRequest &req) {
+        subscriptions.push_back(req.subscription);
+      });
+  ASSERT_NE(nullptr, listener);
+
+  auto now = std::chrono::system_clock::now();
+  bool first_ended = false;
+  listener->Subscribe(1, now + std::chrono::milliseconds{10},
+                      [&] { first_ended = true; });
+  listener->Subscribe(2, now + std::chrono::milliseconds{50}, [&] {
+    ASSERT_TRUE(first_ended);
+    loop->Stop();
+  });
+  ASSERT_EQ(2, listener->Active());
+
+  auto sender = DatagramSocket::New();
+  ASSERT_NE(nullptr, sender);
+  auto to_addr = DatagramSocket::Resolve("127.0.0.1", listener->Port());
+  ASSERT_TRUE(to_addr.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  for (srpc::u64 subscription : {1, 2}) {
+    ASSERT_TRUE(sender->SendTo(
+        *to_addr, srpc::Marshal<SeatAvailabilityCallbackRequest>{}(
+                      SeatAvailabilityCallbackRequest{
+                          .id = subscription,
+                          .subscription = subscription,
+                          .identifier = 4013,
+                          .sequence = 1,
+                          .seat_availability = 10,
+                      })));
+  }
+  // Anything else arriving at the socket is ignored.
+  std::vector<std::byte> garbage{std::byte{0xff}};
+  ASSERT_TRUE(sender->SendTo(*to_addr, garbage));
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  loop->Run();
+  ASSERT_EQ((std::vector<srpc::u64>{1, 2}), subscriptions);
+  ASSERT_EQ(0, listener->Active());
+}
@@ -0,0 +1,37 @@
+#include "client/callback_sequencer.h"
+
+#include <gtest/gtest.h>
+
+using namespace dfis;
+
+TEST(Client, CallbackSequencerDetectsGaps) {
+  CallbackSequencer sequencer;
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4013, 1));
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4013, 2));
+  ASSERT_EQ(CallbackOrder::kGap, sequencer.Accept(1, 4013, 4));
+  ASSERT_EQ(CallbackOrder::kStale, sequencer.Accept(1, 4013, 3));
+  ASSERT_EQ(CallbackOrder::kStale, sequencer.Accept(1, 4013, 4));
+  // Flights and subscriptions are numbered independently.
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4012, 1));
+  ASSERT_EQ(CallbackOrder::kGap, sequencer.Accept(2, 4013, 2));
+}
+
+TEST(Client, CallbackSequencerResyncs) {
+  CallbackSequencer sequencer;
+  ASSERT_EQ(CallbackOrder::kGap, sequencer.Accept(1, 4013, 3));
+  ASSERT_FALSE(sequencer.Resync(1, 4013, 3));
+  ASSERT_TRUE(sequencer.Resync(1, 4013, 5));
+  ASSERT_EQ(CallbackOrder::kStale, sequencer.Accept(1, 4013, 4));
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4013, 6));
+}
+
+TEST(Client, CallbackSequencerForgets) {
+  CallbackSequencer sequencer;
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4013, 1));
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4012, 1));
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(2, 4013, 1));
+  sequencer.Forget(1);
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4013, 1));
+  ASSERT_EQ(CallbackOrder::kNext, sequencer.Accept(1, 4012, 1));
+  ASSERT_EQ(CallbackOrder::kStale, sequencer.Accept(2, 4013, 1));
+}
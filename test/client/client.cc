@@ -0,0 +1,105 @@
+#include "client/client.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/seat_reservation.h"
+#include "messages/timed_request.h"
+#include "network/datagram_socket.h"
+
+using namespace dfis;
+
+namespace {
+
+// Receives a request at the server, and returns it unwrapped, with its
+// sender.
+template <typename Req>
+std::optional<std::pair<Req, srpc::SocketAddress>> ReceiveRequest(
+    DatagramSocket &server) {
+  auto datagram = server.ReceiveFrom(std::chrono::seconds{1});
+  if (!datagram.has_value()) {
+    return {};
+  }
+  auto timed_req = srpc::Unmarshal<TimedRequest>{}(datagram->data).second;
+  if (!timed_req.has_value()) {
+    return {};
+  }
+  auto req = srpc::Unmarshal<Req>{}(timed_req->request).second;
+  if (!req.has_value()) {
+    return {};
+  }
+  return std::pair{*req, datagram->from_addr};
+}
+
+}  // namespace
+
+TEST(Client, ClientReservesAndCancels) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  std::string error;
+  auto client = Client::New("127.0.0.1", server->Port(), {}, &error);
+  ASSERT_NE(nullptr, client) << error;
+
+  auto reservation = client->Reserve(4013, 3);
+  auto req1 = ReceiveRequest<SeatReservationRequest>(*server);
+  ASSERT_TRUE(req1.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(4013, req1->first.identifier);
+  ASSERT_EQ(3, req1->first.seats);
+  ASSERT_TRUE(server->SendTo(
+      req1->second,
+      srpc::Marshal<SeatReservationResponse>{}(SeatReservationResponse{
+          .id = req1->first.id,
+          .status_code = 0,
+          .message = {},
+          .identifier = 4013,
+          .seats = 3,
+      })));
+  auto res1 = reservation.get();
+  ASSERT_TRUE(res1.has_value());
+  ASSERT_EQ(0, res1->status_code);
+
+  // The reservation is cancelled by the identifier of its response.
+  auto cancellation = client->Cancel(res1->id, 4013, 1);
+  auto req2 = ReceiveRequest<SeatReservationCancellationRequest>(*server);
+  ASSERT_TRUE(req2.has_value());
+  ASSERT_EQ(req1->first.id, req2->first.reservation_req_id);
+  ASSERT_EQ(1, req2->first.seats);
+  ASSERT_TRUE(server->SendTo(
+      req2->second, srpc::Marshal<SeatReservationCancellationResponse>{}(
+                        SeatReservationCancellationResponse{
+                            .id = req2->first.id,
+                            .status_code = 0,
+                            .message = {},
+                            .identifier = 4013,
+                            .seats = 1,
+                        })));
+  auto res2 = cancellation.get();
+  ASSERT_TRUE(res2.has_value());
+  ASSERT_EQ(1, res2->seats);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  ASSERT_EQ(0, client->Outstanding());
+}
+
+TEST(Client, ClientGivesUpWithoutServer) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  auto client =
+      Client::New("127.0.0.1", server->Port(),
+                  ClientOptions{
+                      .retry_policy =
+                          RetryPolicy{
+                              .initial_timeout = std::chrono::milliseconds{10},
+                              .min_timeout = std::chrono::milliseconds{10},
+                              .retry_times = 1,
+                          },
+                  });
+  ASSERT_NE(nullptr, client);
+  ASSERT_FALSE(client->GetFlightInfo(4013).get().has_value());
+}
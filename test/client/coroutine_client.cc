@@ -0,0 +1,65 @@
+#include "client/coroutine_client.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <srpc/types/serialization.h>
+
+#include "client/client.h"
+#include "messages/seat_reservation.h"
+#include "messages/timed_request.h"
+#include "network/datagram_socket.h"
+#include "network/event_loop.h"
+#include "utils/task.h"
+
+using namespace dfis;
+
+TEST(Client, CoroutineClientReserves) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  std::string error;
+  auto client = Client::New("127.0.0.1", server->Port(), {}, &error);
+  ASSERT_NE(nullptr, client) << error;
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  CoroutineClient coroutine_client{*client, *loop};
+
+  std::optional<SeatReservationResponse> res;
+  std::thread::id resumed_on;
+  loop->Post([&] {
+    Spawn([](CoroutineClient &client, auto &res,
+             std::thread::id &resumed_on) -> Task<> {
+      res = co_await client.Reserve(4013, 3);
+      resumed_on = std::this_thread::get_id();
+      client.Loop().Stop();
+    }(coroutine_client, res, resumed_on));
+  });
+  std::thread runner{[&loop] { loop->Run(); }};
+  auto runner_id = runner.get_id();
+
+  auto datagram = server->ReceiveFrom(std::chrono::seconds{1});
+  ASSERT_TRUE(datagram.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  auto timed_req = srpc::Unmarshal<TimedRequest>{}(datagram->data).second;
+  ASSERT_TRUE(timed_req.has_value());
+  auto req = srpc::Unmarshal<SeatReservationRequest>{}(timed_req->request);
+  ASSERT_TRUE(req.second.has_value());
+  ASSERT_EQ(4013, req.second->identifier);
+  ASSERT_TRUE(server->SendTo(
+      datagram->from_addr,
+      srpc::Marshal<SeatReservationResponse>{}(SeatReservationResponse{
+          .id = req.second->id,
+          .status_code = 0,
+          .message = {},
+          .identifier = 4013,
+          .seats = 3,
+      })));
+  runner.join();
+  ASSERT_EQ(runner_id, resumed_on);
+  ASSERT_TRUE(res.has_value());
+  ASSERT_EQ(3, res->seats);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
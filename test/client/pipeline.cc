@@ -0,0 +1,277 @@
+#include "client/pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/flight_info.h"
+#include "messages/fragment.h"
+#include "messages/timed_request.h"
+#include "network/datagram_socket.h"
+#include "network/fragmentation.h"
+
+using namespace dfis;
+
+namespace {
+
+constexpr std::chrono::seconds kReceiveTimeout{1};
+constexpr std::chrono::milliseconds kShortTimeout{50};
+constexpr std::chrono::milliseconds kShorterTimeout{10};
+
+srpc::SocketAddress LoopbackAddress(const DatagramSocket &socket) {
+  return srpc::SocketAddress{
+      .protocol = srpc::kIPv4,
+      .address = "127.0.0.1",
+      .port = socket.Port(),
+  };
+}
+
+// Receives a request at the server, and returns it with its sender.
+std::pair<FlightInfoRequest, srpc::SocketAddress> ReceiveRequest(
+    DatagramSocket &server) {
+  auto datagram = server.ReceiveFrom(kReceiveTimeout);
+  EXPECT_TRUE(datagram.has_value());
+  if (!datagram.has_value()) {
+    return {};
+  }
+  auto timed_req = srpc::Unmarshal<TimedRequest>{}(datagram->data).second;
+  EXPECT_TRUE(timed_req.has_value());
+  if (!timed_req.has_value()) {
+    return {};
+  }
+  EXPECT_LT(0, timed_req->time_budget_ms);
+  auto req = srpc::Unmarshal<FlightInfoRequest>{}(timed_req->request).second;
+  EXPECT_TRUE(req.has_value());
+  return {req.value_or(FlightInfoRequest{}), datagram->from_addr};
+}
+
+std::vector<std::byte> MakeResponse(const FlightInfoRequest &req,
+                                    std::size_t message_size = 0) {
+  return srpc::Marshal<FlightInfoResponse>{}(FlightInfoResponse{
+      .id = req.id,
+      .status_code = req.identifier,
+      .message = std::string(message_size, 'x'),
+      .flight = {},
+  });
+}
+
+}  // namespace
+
+TEST(Client, PipelineMatchesResponsesOutOfOrder) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  auto socket = DatagramSocket::New();
+  ASSERT_NE(nullptr, socket);
+  RequestPipeline pipeline{*socket, LoopbackAddress(*server)};
+
+  std::vector<std::future<std::optional<FlightInfoResponse>>> futures;
+  for (srpc::i32 identifier : {4011, 4012, 4013}) {
+    futures.push_back(pipeline.Call<FlightInfoRequest, FlightInfoResponse>(
+        FlightInfoRequest{.id = 0, .identifier = identifier}));
+  }
+  // All requests are in flight before any is answered.
+  std::vector<std::pair<FlightInfoRequest, srpc::SocketAddress>> reqs;
+  for (std::size_t i = 0; i < futures.size(); ++i) {
+    reqs.push_back(ReceiveRequest(*server));
+  }
+  ASSERT_EQ(3, pipeline.Outstanding());
+  for (auto it = reqs.rbegin(); it != reqs.rend(); ++it) {
+    ASSERT_TRUE(server->SendTo(it->second, MakeResponse(it->first)));
+  }
+
+  for (std::size_t i = 0; i < futures.size(); ++i) {
+    auto res = futures[i].get();
+    ASSERT_TRUE(res.has_value());
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    ASSERT_EQ(reqs[i].first.identifier, res->status_code);
+  }
+  ASSERT_EQ(0, pipeline.Outstanding());
+}
+
+TEST(Client, PipelineRetransmitsLostRequests) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  auto socket = DatagramSocket::New();
+  ASSERT_NE(nullptr, socket);
+  RequestPipeline pipeline{*socket, LoopbackAddress(*server),
+                           RetryPolicy{
+                               .initial_timeout = kShortTimeout,
+                               .retry_times = 3,
+                           }};
+
+  auto future = pipeline.Call<FlightInfoRequest, FlightInfoResponse>(
+      FlightInfoRequest{.id = 0, .identifier = 4013});
+  // The first copy is lost.
+  auto lost = ReceiveRequest(*server);
+  auto [req, from_addr] = ReceiveRequest(*server);
+  ASSERT_EQ(lost.first.id, req.id);
+  ASSERT_TRUE(server->SendTo(from_addr, MakeResponse(req)));
+  // A late duplicate is ignored.
+  ASSERT_TRUE(server->SendTo(from_addr, MakeResponse(req)));
+
+  auto res = future.get();
+  ASSERT_TRUE(res.has_value());
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  ASSERT_EQ(4013, res->status_code);
+}
+
+TEST(Client, PipelineAsksForMissingFragments) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  auto socket = DatagramSocket::New();
+  ASSERT_NE(nullptr, socket);
+  RequestPipeline pipeline{*socket, LoopbackAddress(*server),
+                           RetryPolicy{
+                               .initial_timeout = kShortTimeout,
+                               .retry_times = 3,
+                           }};
+
+  auto future = pipeline.Call<FlightInfoRequest, FlightInfoResponse>(
+      FlightInfoRequest{.id = 0, .identifier = 4013});
+  auto [req, from_addr] = ReceiveRequest(*server);
+  auto fragments = SplitIntoFragments(
+      req.id, 42, MakeResponse(req, 3 * kMaxFragmentPayload));
+  ASSERT_TRUE(fragments.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_LT(2, fragments->size());
+  for (std::size_t i = 0; i < fragments->size(); ++i) {
+    if (i != 1) {
+      ASSERT_TRUE(server->SendTo(from_addr, (*fragments)[i]));
+    }
+  }
+
+  // Copies of the request itself may arrive first, if sent again before any
+  // fragment arrived.
+  std::optional<FragmentRetransmitRequest> retransmit_req;
+  while (!retransmit_req.has_value()) {
+    auto datagram = server->ReceiveFrom(kReceiveTimeout);
+    ASSERT_TRUE(datagram.has_value());
+    retransmit_req =
+        srpc::Unmarshal<FragmentRetransmitRequest>{}(datagram->data).second;
+  }
+  ASSERT_EQ(42, retransmit_req->message_id);
+  ASSERT_EQ(std::vector<srpc::u16>{1}, retransmit_req->missing);
+  ASSERT_TRUE(server->SendTo(from_addr, (*fragments)[1]));
+
+  auto res = future.get();
+  ASSERT_TRUE(res.has_value());
+  ASSERT_EQ(4013, res->status_code);
+  ASSERT_EQ(3 * kMaxFragmentPayload, res->message.size());
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Client, PipelineGivesUpAfterRetries) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  auto socket = DatagramSocket::New();
+  ASSERT_NE(nullptr, socket);
+  RequestPipeline pipeline{*socket, LoopbackAddress(*server),
+                           RetryPolicy{
+                               .initial_timeout = kShorterTimeout,
+                               .min_timeout = kShorterTimeout,
+                               .retry_times = 1,
+                           }};
+
+  auto future = pipeline.Call<FlightInfoRequest, FlightInfoResponse>(
+      FlightInfoRequest{.id = 0, .identifier = 4013});
+  ASSERT_FALSE(future.get().has_value());
+  ASSERT_EQ(0, pipeline.Outstanding());
+  // Sent once, and then once again with less time left.
+  std::vector<srpc::u32> time_budgets;
+  for (int i = 0; i < 2; ++i) {
+    auto datagram = server->ReceiveFrom(kReceiveTimeout);
+    ASSERT_TRUE(datagram.has_value());
+    auto timed_req = srpc::Unmarshal<TimedRequest>{}(datagram->data).second;
+    ASSERT_TRUE(timed_req.has_value());
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    time_budgets.push_back(timed_req->time_budget_ms);
+  }
+  // Every timeout is waited for before giving up.
+  ASSERT_EQ(3 * kShorterTimeout.count(), time_budgets[0]);
+  ASSERT_GT(time_budgets[0], time_budgets[1]);
+  ASSERT_FALSE(
+      server->ReceiveFrom(std::chrono::milliseconds{50}).has_value());
+}
+
+TEST(Client, PipelineAdaptsToRisingLatency) {
+  auto server = DatagramSocket::New();
+  ASSERT_NE(nullptr, server);
+  auto socket = DatagramSocket::New();
+  ASSERT_NE(nullptr, socket);
+  // Gives up after 10 + 20 ms while the timeout is at its minimum.
+  RequestPipeline pipeline{*socket, LoopbackAddress(*server),
+                           RetryPolicy{
+                               .initial_timeout = kShorterTimeout,
+                               .min_timeout = kShorterTimeout,
+                               .retry_times = 1,
+                               .jitter = 0,
+                           }};
+
+  // Answers every copy of a request after the delay.
+  std::atomic<int> delay_ms = 0;
+  std::atomic<bool> stopping = false;
+  std::thread responder{[&] {
+    std::vector<std::thread> replies;
+    while (!stopping) {
+      auto datagram = server->ReceiveFrom(kShorterTimeout);
+      if (!datagram.has_value()) {
+        continue;
+      }
+      auto timed_req = srpc::Unmarshal<TimedRequest>{}(datagram->data).second;
+      if (!timed_req.has_value()) {
+        continue;
+      }
+      auto req =
+          srpc::Unmarshal<FlightInfoRequest>{}(timed_req->request).second;
+      if (!req.has_value()) {
+        continue;
+      }
+      replies.emplace_back([&server, delay = std::chrono::milliseconds{
+                                         delay_ms.load()},
+                            res_data = MakeResponse(*req),
+                            to_addr = datagram->from_addr] {
+        std::this_thread::sleep_for(delay);
+        server->SendTo(to_addr, res_data);
+      });
+    }
+    for (auto &reply : replies) {
+      reply.join();
+    }
+  }};
+
+  auto call = [&pipeline] {
+    return pipeline
+        .Call<FlightInfoRequest, FlightInfoResponse>(
+            FlightInfoRequest{.id = 0, .identifier = 4013})
+        .get()
+        .has_value();
+  };
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(call());
+  }
+  // Beyond what the timeout learnt allows. No sample can be taken until the
+  // timeout backs off past it, which it must do for good.
+  delay_ms = 60;
+  std::vector<bool> succeeded;
+  for (int i = 0; i < 10; ++i) {
+    succeeded.push_back(call());
+  }
+  stopping = true;
+  responder.join();
+  // The first few calls may fail while the timeout backs off.
+  for (std::size_t i = 5; i < succeeded.size(); ++i) {
+    ASSERT_TRUE(succeeded[i]) << "call " << i;
+  }
+}
@@ -0,0 +1,96 @@
+#include "messages/batch.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/flight_info.h"
+#include "messages/seat_reservation.h"
+#include "utils/rand.h"
+
+using namespace dfis;
+
+TEST(Message, MarshalAndUnmarshalBatchRequests) {
+  FlightInfoRequest info_req{
+      .id = MakeMessageIdentifier(),
+      .identifier = 4013,
+  };
+  SeatReservationRequest reservation_req{
+      .id = MakeMessageIdentifier(),
+      .identifier = 4013,
+      .seats = 3,
+  };
+  BatchRequest req1{
+      .id = MakeMessageIdentifier(),
+      .requests =
+          {
+              srpc::Marshal<FlightInfoRequest>{}(info_req),
+              srpc::Marshal<SeatReservationRequest>{}(reservation_req),
+          },
+  };
+  auto data1 = srpc::Marshal<BatchRequest>{}(req1);
+  ASSERT_EQ(SerializedSize(req1), data1.size());
+  auto res1 = srpc::Unmarshal<BatchRequest>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.requests, res1.second->requests);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  auto res2 = srpc::Unmarshal<BatchRequestView>{}(data1);
+  ASSERT_TRUE(res2.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, res2.second->id);
+  ASSERT_EQ(req1.requests.size(), res2.second->requests.size());
+  for (std::size_t i = 0; i < req1.requests.size(); ++i) {
+    auto request = res2.second->requests[i];
+    ASSERT_EQ(req1.requests[i],
+              std::vector<std::byte>(request.begin(), request.end()));
+    // Decoded in place.
+    ASSERT_GE(request.data(), data1.data());
+    ASSERT_LT(request.data(), data1.data() + data1.size());
+  }
+  auto res3 = srpc::Unmarshal<SeatReservationRequest>{}(
+      res2.second->requests[1]);
+  ASSERT_TRUE(res3.second.has_value());
+  ASSERT_EQ(reservation_req.seats, res3.second->seats);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  data1.pop_back();
+  ASSERT_FALSE(srpc::Unmarshal<BatchRequest>{}(data1).second.has_value());
+  ASSERT_FALSE(srpc::Unmarshal<BatchRequestView>{}(data1).second.has_value());
+}
+
+TEST(Message, MarshalAndUnmarshalBatchResponses) {
+  SeatReservationResponse reservation_resp{
+      .id = MakeMessageIdentifier(),
+      .status_code = 0,
+      .message = {},
+      .identifier = 4013,
+      .seats = 3,
+  };
+  BatchResponse resp1{
+      .id = MakeMessageIdentifier(),
+      .status_code = 0,
+      .message = {},
+      .responses =
+          {
+              {},
+              srpc::Marshal<SeatReservationResponse>{}(reservation_resp),
+          },
+  };
+  auto data1 = srpc::Marshal<BatchResponse>{}(resp1);
+  ASSERT_EQ(SerializedSize(resp1), data1.size());
+  auto res1 = srpc::Unmarshal<BatchResponse>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(resp1.id, res1.second->id);
+  ASSERT_EQ(resp1.status_code, res1.second->status_code);
+  ASSERT_EQ(resp1.responses, res1.second->responses);
+  ASSERT_TRUE(res1.second->responses[0].empty());
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
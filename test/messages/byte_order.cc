@@ -0,0 +1,103 @@
+#include "messages/byte_order.h"
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+using namespace dfis;
+
+namespace {
+
+// Distinct values of either sign, in lengths covering whole vector
+// blocks as well as the tails left over from them.
+template <typename T>
+std::vector<T> MakeValues(std::size_t count) {
+  std::vector<T> values;
+  for (std::size_t i = 0; i < count; ++i) {
+    values.push_back(static_cast<T>(
+        (i % 2 == 0 ? std::numeric_limits<T>::max()
+                    : std::numeric_limits<T>::lowest()) /
+        static_cast<T>(i + 1)));
+  }
+  return values;
+}
+
+// Marshals element by element through srpc.
+template <typename T>
+std::vector<std::byte> MarshalEach(const std::vector<T> &values) {
+  std::vector<std::byte> data;
+  for (const auto &value : values) {
+    auto element = srpc::Marshal<T>{}(value);
+    data.insert(data.end(), element.begin(), element.end());
+  }
+  return data;
+}
+
+template <typename T>
+void ExpectMatchesSrpc() {
+  for (std::size_t count = 0; count <= 70; ++count) {
+    auto values = MakeValues<T>(count);
+    auto expected = MarshalEach(values);
+
+    std::vector<std::byte> data(values.size() * sizeof(T));
+    EncodeBigEndian(std::span<const T>{values}, data.data());
+    ASSERT_EQ(expected, data) << "count " << count;
+
+    std::vector<std::byte> stored(values.size() * sizeof(T));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      StoreBigEndian(values[i], stored.data() + i * sizeof(T));
+    }
+    ASSERT_EQ(expected, stored) << "count " << count;
+
+    std::vector<T> decoded(count);
+    DecodeBigEndian(data.data(), std::span<T>{decoded});
+    ASSERT_EQ(values, decoded) << "count " << count;
+  }
+}
+
+}  // namespace
+
+TEST(ByteOrder, MatchSrpcForIntegers) {
+  ExpectMatchesSrpc<srpc::i8>();
+  ExpectMatchesSrpc<srpc::i16>();
+  ExpectMatchesSrpc<srpc::u16>();
+  ExpectMatchesSrpc<srpc::i32>();
+  ExpectMatchesSrpc<srpc::u32>();
+  ExpectMatchesSrpc<srpc::i64>();
+  ExpectMatchesSrpc<srpc::u64>();
+}
+
+TEST(ByteOrder, MatchSrpcForFloats) {
+  ExpectMatchesSrpc<srpc::f32>();
+  ExpectMatchesSrpc<srpc::f64>();
+}
+
+TEST(ByteOrder, KernelsAgree) {
+  namespace internal = byte_order_internal;
+  std::vector<std::byte> in(100);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = std::byte(i);
+  }
+  for (std::size_t width : {2, 4, 8}) {
+    std::vector<std::byte> expected(in.size());
+    internal::SwapPortable(in.data(), expected.data(), 96, width);
+    ASSERT_EQ(std::byte(width - 1), expected[0]);
+    ASSERT_EQ(std::byte{0}, expected[width - 1]);
+    if (internal::HasSsse3()) {
+      std::vector<std::byte> out(in.size());
+      ASSERT_EQ(96, internal::SwapSsse3(in.data(), out.data(), 96, width));
+      ASSERT_EQ(expected, out) << "width " << width;
+    }
+    if (internal::HasAvx2()) {
+      std::vector<std::byte> out(in.size());
+      ASSERT_EQ(96, internal::SwapAvx2(in.data(), out.data(), 96, width));
+      ASSERT_EQ(expected, out) << "width " << width;
+    }
+  }
+}
@@ -0,0 +1,163 @@
+#include "messages/codec.h"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/floats.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/flight.h"
+#include "messages/message_type.h"
+#include "messages/seat_availability.h"
+#include "messages/seat_reservation.h"
+#include "messages/wire.h"
+#include "utils/rand.h"
+
+using namespace dfis;
+
+namespace {
+
+struct Sample {
+  static constexpr MessageType kMessageType =
+      MessageType::kRouteMonitoringRequest;
+  srpc::u64 id;
+  srpc::i32 identifier;
+  std::string name;
+  SeatAvailabilityTrigger trigger;
+  srpc::f32 airfare;
+  std::vector<srpc::i32> identifiers;
+  std::vector<Flight> flights;
+
+  static constexpr auto Fields() {
+    return std::tuple{
+        &Sample::id,
+        &Sample::identifier,
+        &Sample::name,
+        &Sample::trigger,
+        &Sample::airfare,
+        &Sample::identifiers,
+        &Sample::flights,
+    };
+  }
+};
+
+struct SampleView {
+  static constexpr MessageType kMessageType = Sample::kMessageType;
+  srpc::u64 id;
+  srpc::i32 identifier;
+  std::string_view name;
+
+  static constexpr auto Fields() {
+    return std::tuple{&SampleView::id, &SampleView::identifier,
+                      &SampleView::name};
+  }
+};
+
+Sample MakeSample() {
+  return Sample{
+      .id = 42,
+      .identifier = 4013,
+      .name = "Singapore",
+      .trigger = SeatAvailabilityTrigger::kCrosses,
+      .airfare = 314.15,
+      .identifiers = {4011, 4012},
+      .flights = {Flight{
+          .identifier = 4013,
+          .source = "Guangzhou",
+          .destination = "Singapore",
+          .departure_time = 1675526400,
+          .airfare = 314.15,
+          .seat_availability = 42,
+      }},
+  };
+}
+
+}  // namespace
+
+TEST(Codec, GroupFixedWidthFieldsIntoRuns) {
+  ASSERT_EQ(2, codec_internal::RunEnd<Sample>(0));
+  ASSERT_EQ(12, codec_internal::Offset<Sample>(0, 2));
+  ASSERT_EQ(5, codec_internal::RunEnd<Sample>(3));
+  ASSERT_EQ(5, codec_internal::Offset<Sample>(3, 5));
+  ASSERT_EQ(5, codec_internal::RunEnd<Sample>(5));
+}
+
+TEST(Codec, EncodeAndDecode) {
+  auto sample = MakeSample();
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  Encode(sample, writer);
+
+  auto res = Decode<Sample>(data);
+  ASSERT_TRUE(res.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(data.size(), res.first);
+  ASSERT_EQ(sample.id, res.second->id);
+  ASSERT_EQ(sample.identifier, res.second->identifier);
+  ASSERT_EQ(sample.name, res.second->name);
+  ASSERT_EQ(sample.trigger, res.second->trigger);
+  ASSERT_EQ(sample.airfare, res.second->airfare);
+  ASSERT_EQ(sample.identifiers, res.second->identifiers);
+  ASSERT_EQ(sample.flights, res.second->flights);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  auto view_res = Decode<SampleView>(data);
+  ASSERT_TRUE(view_res.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(sample.name, view_res.second->name);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Codec, ComputeSerializedSizes) {
+  static_assert(FixedLayout<SeatReservationRequest>);
+  static_assert(!FixedLayout<Sample>);
+  static_assert(kSerializedSize<SeatReservationRequest> == 20);
+  static_assert(kSerializedSize<SeatAvailabilityCallbackRequest> == 36);
+
+  auto sample = MakeSample();
+  auto data = MarshalToVector(sample);
+  ASSERT_EQ(SerializedSize(sample), data.size());
+  ASSERT_EQ(data.size(), data.capacity());
+
+  SeatReservationRequest req{.id = 1, .identifier = 4013, .seats = 2};
+  auto req_data = srpc::Marshal<SeatReservationRequest>{}(req);
+  ASSERT_EQ(kSerializedSize<SeatReservationRequest>, req_data.size());
+  ASSERT_EQ(req_data.size(), req_data.capacity());
+}
+
+TEST(Codec, RejectTruncatedAndMistypedMessages) {
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  Encode(MakeSample(), writer);
+  ASSERT_FALSE(Decode<SeatAvailabilityMonitoringRequest>(data)
+                   .second.has_value());
+  for (std::size_t size = 0; size < data.size(); ++size) {
+    ASSERT_FALSE(
+        Decode<Sample>(std::span<const std::byte>{data.data(), size})
+            .second.has_value());
+  }
+}
+
+TEST(Codec, DecodeMessageHeaders) {
+  SeatReservationResponse resp1{
+      .id = MakeMessageIdentifier(),
+      .status_code = 0,
+      .message = {},
+      .identifier = 4013,
+      .seats = 3,
+  };
+  auto data1 = srpc::Marshal<SeatReservationResponse>{}(resp1);
+  auto res1 = Decode<MessageHeader>(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(static_cast<srpc::i32>(MessageType::kSeatReservationResponse),
+            res1.second->type);
+  ASSERT_EQ(resp1.id, res1.second->id);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
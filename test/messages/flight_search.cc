@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/id_list.h"
 #include "utils/rand.h"
 
 using namespace dfis;
@@ -12,6 +13,9 @@ TEST(Message, MarshalAndUnmarshalFlightSearchRequests) {
       .id = MakeMessageIdentifier(),
       .source = "Guangzhou",
       .destination = "Singapore",
+      .encoding = IdListEncoding::kDeltaVarint,
+      .page_size = 20,
+      .cursor = 40,
   };
   auto data1 = srpc::Marshal<FlightSearchRequest>{}(req1);
   auto res1 = srpc::Unmarshal<FlightSearchRequest>{}(data1);
@@ -20,9 +24,42 @@ TEST(Message, MarshalAndUnmarshalFlightSearchRequests) {
   ASSERT_EQ(req1.id, res1.second->id);
   ASSERT_EQ(req1.source, res1.second->source);
   ASSERT_EQ(req1.destination, res1.second->destination);
+  ASSERT_EQ(req1.encoding, res1.second->encoding);
+  ASSERT_EQ(req1.page_size, res1.second->page_size);
+  ASSERT_EQ(req1.cursor, res1.second->cursor);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
 
+TEST(Message, UnmarshalFlightSearchRequestsInPlace) {
+  FlightSearchRequest req1{
+      .id = MakeMessageIdentifier(),
+      .source = "Guangzhou",
+      .destination = "Singapore",
+      .encoding = IdListEncoding::kDeltaVarint,
+      .page_size = 20,
+      .cursor = 40,
+  };
+  auto data1 = srpc::Marshal<FlightSearchRequest>{}(req1);
+  auto res1 = srpc::Unmarshal<FlightSearchRequestView>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(data1.size(), res1.first);
+  ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.source, res1.second->source);
+  ASSERT_EQ(req1.destination, res1.second->destination);
+  ASSERT_EQ(req1.cursor, res1.second->ToRequest().cursor);
+  // The views point into the buffer rather than at copies.
+  const auto *begin = reinterpret_cast<const char *>(data1.data());
+  ASSERT_GE(res1.second->source.data(), begin);
+  ASSERT_LE(res1.second->destination.data() + req1.destination.size(),
+            begin + data1.size());
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  data1.pop_back();
+  ASSERT_FALSE(
+      srpc::Unmarshal<FlightSearchRequestView>{}(data1).second.has_value());
+}
+
 TEST(Message, MarshalAndUnmarshalFlightSearchResponses) {
   auto assert_eq = [](auto expected, auto actual) {
     ASSERT_EQ(expected.size(), actual.size());
@@ -35,7 +72,8 @@ TEST(Message, MarshalAndUnmarshalFlightSearchResponses) {
       .id = MakeMessageIdentifier(),
       .status_code = 1,
       .message = "Flights not found",
-      .flights = {},
+      .flights = {.encoding = IdListEncoding::kFixed, .ids = {}},
+      .next_cursor = 0,
   };
   auto data1 = srpc::Marshal<FlightSearchResponse>{}(resp1);
   auto res1 = srpc::Unmarshal<FlightSearchResponse>{}(data1);
@@ -44,14 +82,18 @@ TEST(Message, MarshalAndUnmarshalFlightSearchResponses) {
   ASSERT_EQ(resp1.id, res1.second->id);
   ASSERT_EQ(resp1.status_code, res1.second->status_code);
   ASSERT_EQ(resp1.message, res1.second->message);
-  assert_eq(resp1.flights, res1.second->flights);
+  ASSERT_EQ(resp1.flights.encoding, res1.second->flights.encoding);
+  assert_eq(resp1.flights.ids, res1.second->flights.ids);
+  ASSERT_EQ(resp1.next_cursor, res1.second->next_cursor);
   // NOLINTEND(bugprone-unchecked-optional-access)
 
   FlightSearchResponse resp2{
       .id = MakeMessageIdentifier(),
       .status_code = 0,
       .message = {},
-      .flights = {4013, 4014},
+      .flights = {.encoding = IdListEncoding::kDeltaVarint,
+                  .ids = {4013, 4014}},
+      .next_cursor = 2,
   };
   auto data2 = srpc::Marshal<dfis::FlightSearchResponse>{}(resp2);
   auto res2 = srpc::Unmarshal<dfis::FlightSearchResponse>{}(data2);
@@ -60,7 +102,9 @@ TEST(Message, MarshalAndUnmarshalFlightSearchResponses) {
   ASSERT_EQ(resp2.id, res2.second->id);
   ASSERT_EQ(resp2.status_code, res2.second->status_code);
   ASSERT_EQ(resp2.message, res2.second->message);
-  assert_eq(resp2.flights, res2.second->flights);
+  ASSERT_EQ(resp2.flights.encoding, res2.second->flights.encoding);
+  assert_eq(resp2.flights.ids, res2.second->flights.ids);
+  ASSERT_EQ(resp2.next_cursor, res2.second->next_cursor);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
 
@@ -69,6 +113,9 @@ TEST(Message, MarshalAndUnmarshalPriceRangeSearchRequests) {
       .id = MakeMessageIdentifier(),
       .from = 100.0,
       .to = 200.0,
+      .encoding = IdListEncoding::kFixed,
+      .page_size = 0,
+      .cursor = 0,
   };
   auto data1 = srpc::Marshal<PriceRangeSearchRequest>{}(req1);
   auto res1 = srpc::Unmarshal<PriceRangeSearchRequest>{}(data1);
@@ -77,7 +124,12 @@ TEST(Message, MarshalAndUnmarshalPriceRangeSearchRequests) {
   ASSERT_EQ(req1.id, res1.second->id);
   ASSERT_EQ(req1.from, res1.second->from);
   ASSERT_EQ(req1.to, res1.second->to);
+  ASSERT_EQ(req1.encoding, res1.second->encoding);
+  ASSERT_EQ(req1.page_size, res1.second->page_size);
+  ASSERT_EQ(req1.cursor, res1.second->cursor);
   // NOLINTEND(bugprone-unchecked-optional-access)
+  ASSERT_FALSE(
+      srpc::Unmarshal<FlightSearchRequest>{}(data1).second.has_value());
 }
 
 TEST(Message, MarshalAndUnmarshalPriceRangeSearchResponses) {
@@ -92,7 +144,8 @@ TEST(Message, MarshalAndUnmarshalPriceRangeSearchResponses) {
       .id = MakeMessageIdentifier(),
       .status_code = 1,
       .message = "Flights not found",
-      .flights = {},
+      .flights = {.encoding = IdListEncoding::kFixed, .ids = {}},
+      .next_cursor = 0,
   };
   auto data1 = srpc::Marshal<PriceRangeSearchResponse>{}(resp1);
   auto res1 = srpc::Unmarshal<PriceRangeSearchResponse>{}(data1);
@@ -101,14 +154,18 @@ TEST(Message, MarshalAndUnmarshalPriceRangeSearchResponses) {
   ASSERT_EQ(resp1.id, res1.second->id);
   ASSERT_EQ(resp1.status_code, res1.second->status_code);
   ASSERT_EQ(resp1.message, res1.second->message);
-  assert_eq(resp1.flights, res1.second->flights);
+  ASSERT_EQ(resp1.flights.encoding, res1.second->flights.encoding);
+  assert_eq(resp1.flights.ids, res1.second->flights.ids);
+  ASSERT_EQ(resp1.next_cursor, res1.second->next_cursor);
   // NOLINTEND(bugprone-unchecked-optional-access)
 
   PriceRangeSearchResponse resp2{
       .id = MakeMessageIdentifier(),
       .status_code = 0,
       .message = {},
-      .flights = {4013, 4014},
+      .flights = {.encoding = IdListEncoding::kDeltaVarint,
+                  .ids = {4013, 4014}},
+      .next_cursor = 2,
   };
   auto data2 = srpc::Marshal<dfis::PriceRangeSearchResponse>{}(resp2);
   auto res2 = srpc::Unmarshal<dfis::PriceRangeSearchResponse>{}(data2);
@@ -117,6 +174,8 @@ TEST(Message, MarshalAndUnmarshalPriceRangeSearchResponses) {
   ASSERT_EQ(resp2.id, res2.second->id);
   ASSERT_EQ(resp2.status_code, res2.second->status_code);
   ASSERT_EQ(resp2.message, res2.second->message);
-  assert_eq(resp2.flights, res2.second->flights);
+  ASSERT_EQ(resp2.flights.encoding, res2.second->flights.encoding);
+  assert_eq(resp2.flights.ids, res2.second->flights.ids);
+  ASSERT_EQ(resp2.next_cursor, res2.second->next_cursor);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
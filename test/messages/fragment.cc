@@ -0,0 +1,56 @@
+#include "messages/fragment.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "utils/rand.h"
+
+using namespace dfis;
+
+TEST(Message, MarshalAndUnmarshalFragments) {
+  std::vector<std::byte> payload{std::byte{40}, std::byte{13}, std::byte{0}};
+  Fragment fragment1{
+      .request_id = MakeMessageIdentifier(),
+      .message_id = MakeMessageIdentifier(),
+      .index = 2,
+      .count = 5,
+      .payload = payload,
+  };
+  auto data1 = srpc::Marshal<Fragment>{}(fragment1);
+  ASSERT_EQ(SerializedSize(fragment1), data1.size());
+  auto res1 = srpc::Unmarshal<Fragment>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(fragment1.request_id, res1.second->request_id);
+  ASSERT_EQ(fragment1.message_id, res1.second->message_id);
+  ASSERT_EQ(fragment1.index, res1.second->index);
+  ASSERT_EQ(fragment1.count, res1.second->count);
+  ASSERT_EQ(payload, std::vector<std::byte>(res1.second->payload.begin(),
+                                            res1.second->payload.end()));
+  // Decoded in place.
+  ASSERT_GE(res1.second->payload.data(), data1.data());
+  ASSERT_LT(res1.second->payload.data(), data1.data() + data1.size());
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  data1.pop_back();
+  ASSERT_FALSE(srpc::Unmarshal<Fragment>{}(data1).second.has_value());
+}
+
+TEST(Message, MarshalAndUnmarshalFragmentRetransmitRequests) {
+  FragmentRetransmitRequest req1{
+      .message_id = MakeMessageIdentifier(),
+      .missing = {0, 3, 4},
+  };
+  auto data1 = srpc::Marshal<FragmentRetransmitRequest>{}(req1);
+  auto res1 = srpc::Unmarshal<FragmentRetransmitRequest>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.message_id, res1.second->message_id);
+  ASSERT_EQ(req1.missing, res1.second->missing);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
@@ -0,0 +1,78 @@
+#include "messages/id_list.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+
+#include "messages/wire.h"
+
+using namespace dfis;
+
+namespace {
+
+IdList RoundTrip(const IdList &list) {
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  FieldCodec<IdList>::Encode(list, writer);
+  EXPECT_EQ(FieldCodec<IdList>::Size(list), data.size());
+
+  IdList decoded{};
+  ByteReader reader{data};
+  EXPECT_TRUE(FieldCodec<IdList>::Decode(reader, decoded));
+  EXPECT_EQ(data.size(), reader.Position());
+  return decoded;
+}
+
+}  // namespace
+
+TEST(IdList, EncodeAndDecodeFixed) {
+  IdList list{
+      .encoding = IdListEncoding::kFixed,
+      .ids = {4011, 4013, 4014},
+  };
+  ASSERT_EQ(list, RoundTrip(list));
+}
+
+TEST(IdList, EncodeAndDecodeDeltaVarints) {
+  std::vector<srpc::i32> sorted;
+  for (srpc::i32 id = 4000; id < 4100; ++id) {
+    sorted.push_back(id);
+  }
+  IdList list{.encoding = IdListEncoding::kDeltaVarint, .ids = sorted};
+  ASSERT_EQ(list, RoundTrip(list));
+  // Two bytes for the first identifier, and one for each after it.
+  ASSERT_EQ(2 + sorted.size() - 1, DeltaVarintsSize(sorted));
+
+  IdList unsorted{
+      .encoding = IdListEncoding::kDeltaVarint,
+      .ids = {std::numeric_limits<srpc::i32>::max(), -1, 0,
+              std::numeric_limits<srpc::i32>::min(), 4013, 4013},
+  };
+  ASSERT_EQ(unsorted, RoundTrip(unsorted));
+
+  IdList empty{.encoding = IdListEncoding::kDeltaVarint, .ids = {}};
+  ASSERT_EQ(empty, RoundTrip(empty));
+}
+
+TEST(IdList, RejectMalformedDeltaVarints) {
+  std::vector<srpc::i32> ids{4013, 4014, 4015};
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  EncodeDeltaVarints(ids, writer);
+
+  std::vector<srpc::i32> decoded;
+  ASSERT_TRUE(DecodeDeltaVarints(data, ids.size(), decoded));
+  ASSERT_EQ(ids, decoded);
+  decoded.clear();
+  ASSERT_FALSE(DecodeDeltaVarints(data, ids.size() - 1, decoded));
+  decoded.clear();
+  ASSERT_FALSE(DecodeDeltaVarints(data, ids.size() + 1, decoded));
+
+  // An unterminated varint.
+  std::vector<std::byte> unterminated(6, std::byte{0xff});
+  decoded.clear();
+  ASSERT_FALSE(DecodeDeltaVarints(unterminated, 1, decoded));
+}
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <srpc/types/serialization.h>
 
+#include "messages/flight_search.h"
 #include "utils/rand.h"
 
 using namespace dfis;
@@ -13,6 +14,9 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityMonitoringRequests) {
       .identifier = 4013,
       .port = 65535,
       .monitor_interval_sec = 60,
+      .coalesce_window_ms = 250,
+      .trigger = SeatAvailabilityTrigger::kFallsBelow,
+      .threshold = 10,
   };
   auto data1 = srpc::Marshal<SeatAvailabilityMonitoringRequest>{}(req1);
   auto res1 = srpc::Unmarshal<SeatAvailabilityMonitoringRequest>{}(data1);
@@ -22,6 +26,9 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityMonitoringRequests) {
   ASSERT_EQ(req1.identifier, res1.second->identifier);
   ASSERT_EQ(req1.port, res1.second->port);
   ASSERT_EQ(req1.monitor_interval_sec, res1.second->monitor_interval_sec);
+  ASSERT_EQ(req1.coalesce_window_ms, res1.second->coalesce_window_ms);
+  ASSERT_EQ(req1.trigger, res1.second->trigger);
+  ASSERT_EQ(req1.threshold, res1.second->threshold);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
 
@@ -31,6 +38,7 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityMonitoringResponses) {
       .status_code = 1,
       .message = "Flight not found",
       .identifier = 4012,
+      .subscription = 0,
       .monitor_end = 0,
   };
   auto data1 = srpc::Marshal<SeatAvailabilityMonitoringResponse>{}(resp1);
@@ -41,6 +49,7 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityMonitoringResponses) {
   ASSERT_EQ(resp1.status_code, res1.second->status_code);
   ASSERT_EQ(resp1.message, res1.second->message);
   ASSERT_EQ(resp1.identifier, res1.second->identifier);
+  ASSERT_EQ(resp1.subscription, res1.second->subscription);
   ASSERT_EQ(resp1.monitor_end, res1.second->monitor_end);
   // NOLINTEND(bugprone-unchecked-optional-access)
 
@@ -49,6 +58,7 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityMonitoringResponses) {
       .status_code = 0,
       .message = {},
       .identifier = 4013,
+      .subscription = 7,
       .monitor_end = 1675612800,
   };
   auto data2 = srpc::Marshal<dfis::SeatAvailabilityMonitoringResponse>{}(resp2);
@@ -60,14 +70,105 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityMonitoringResponses) {
   ASSERT_EQ(resp2.status_code, res2.second->status_code);
   ASSERT_EQ(resp2.message, res2.second->message);
   ASSERT_EQ(resp2.identifier, res2.second->identifier);
+  ASSERT_EQ(resp2.subscription, res2.second->subscription);
   ASSERT_EQ(resp2.monitor_end, res2.second->monitor_end);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
 
+TEST(Message, MarshalAndUnmarshalRouteMonitoringRequests) {
+  RouteMonitoringRequest req1{
+      .id = MakeMessageIdentifier(),
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_from = 1675526400,
+      .departure_to = 0,
+      .port = 65535,
+      .monitor_interval_sec = 60,
+      .coalesce_window_ms = 0,
+      .trigger = SeatAvailabilityTrigger::kCrosses,
+      .threshold = 5,
+  };
+  auto data1 = srpc::Marshal<RouteMonitoringRequest>{}(req1);
+  auto res1 = srpc::Unmarshal<RouteMonitoringRequest>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.source, res1.second->source);
+  ASSERT_EQ(req1.destination, res1.second->destination);
+  ASSERT_EQ(req1.departure_from, res1.second->departure_from);
+  ASSERT_EQ(req1.departure_to, res1.second->departure_to);
+  ASSERT_EQ(req1.port, res1.second->port);
+  ASSERT_EQ(req1.monitor_interval_sec, res1.second->monitor_interval_sec);
+  ASSERT_EQ(req1.coalesce_window_ms, res1.second->coalesce_window_ms);
+  ASSERT_EQ(req1.trigger, res1.second->trigger);
+  ASSERT_EQ(req1.threshold, res1.second->threshold);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  ASSERT_FALSE(
+      srpc::Unmarshal<SeatAvailabilityMonitoringRequest>{}(data1)
+          .second.has_value());
+}
+
+TEST(Message, UnmarshalRouteMonitoringRequestsInPlace) {
+  RouteMonitoringRequest req1{
+      .id = MakeMessageIdentifier(),
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_from = 1675526400,
+      .departure_to = 1675612800,
+      .port = 65535,
+      .monitor_interval_sec = 60,
+      .coalesce_window_ms = 250,
+      .trigger = SeatAvailabilityTrigger::kFallsBelow,
+      .threshold = 5,
+  };
+  auto data1 = srpc::Marshal<RouteMonitoringRequest>{}(req1);
+  auto res1 = srpc::Unmarshal<RouteMonitoringRequestView>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  auto req2 = res1.second->ToRequest();
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, req2.id);
+  ASSERT_EQ(req1.source, req2.source);
+  ASSERT_EQ(req1.destination, req2.destination);
+  ASSERT_EQ(req1.departure_from, req2.departure_from);
+  ASSERT_EQ(req1.departure_to, req2.departure_to);
+  ASSERT_EQ(req1.port, req2.port);
+  ASSERT_EQ(req1.monitor_interval_sec, req2.monitor_interval_sec);
+  ASSERT_EQ(req1.coalesce_window_ms, req2.coalesce_window_ms);
+  ASSERT_EQ(req1.trigger, req2.trigger);
+  ASSERT_EQ(req1.threshold, req2.threshold);
+  ASSERT_FALSE(
+      srpc::Unmarshal<FlightSearchRequestView>{}(data1).second.has_value());
+}
+
+TEST(Message, MarshalAndUnmarshalRouteMonitoringResponses) {
+  RouteMonitoringResponse resp1{
+      .id = MakeMessageIdentifier(),
+      .status_code = 0,
+      .message = {},
+      .flights = {4012, 4013},
+      .subscription = 7,
+      .monitor_end = 1675612800,
+  };
+  auto data1 = srpc::Marshal<RouteMonitoringResponse>{}(resp1);
+  auto res1 = srpc::Unmarshal<RouteMonitoringResponse>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(resp1.id, res1.second->id);
+  ASSERT_EQ(resp1.status_code, res1.second->status_code);
+  ASSERT_EQ(resp1.message, res1.second->message);
+  ASSERT_EQ(resp1.flights, res1.second->flights);
+  ASSERT_EQ(resp1.subscription, res1.second->subscription);
+  ASSERT_EQ(resp1.monitor_end, res1.second->monitor_end);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
 TEST(Message, MarshalAndUnmarshalSeatAvailabilityCallbackRequests) {
   SeatAvailabilityCallbackRequest req1{
       .id = MakeMessageIdentifier(),
+      .subscription = 7,
       .identifier = 4013,
+      .sequence = 2,
       .seat_availability = 39,
   };
   auto data1 = srpc::Marshal<SeatAvailabilityCallbackRequest>{}(req1);
@@ -75,20 +176,87 @@ TEST(Message, MarshalAndUnmarshalSeatAvailabilityCallbackRequests) {
   ASSERT_TRUE(res1.second.has_value());
   // NOLINTBEGIN(bugprone-unchecked-optional-access)
   ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.subscription, res1.second->subscription);
   ASSERT_EQ(req1.identifier, res1.second->identifier);
+  ASSERT_EQ(req1.sequence, res1.second->sequence);
   ASSERT_EQ(req1.seat_availability, res1.second->seat_availability);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
 
-TEST(Message, MarshalAndUnmarshalSeatAvailabilityCallbackResponses) {
-  SeatAvailabilityCallbackResponse resp1{
+TEST(Message, MarshalAndUnmarshalSeatAvailabilitySnapshotRequests) {
+  SeatAvailabilitySnapshotRequest req1{
+      .id = MakeMessageIdentifier(),
+      .subscription = 7,
+      .identifier = 4013,
+  };
+  auto data1 = srpc::Marshal<SeatAvailabilitySnapshotRequest>{}(req1);
+  auto res1 = srpc::Unmarshal<SeatAvailabilitySnapshotRequest>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.subscription, res1.second->subscription);
+  ASSERT_EQ(req1.identifier, res1.second->identifier);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Message, MarshalAndUnmarshalSeatAvailabilitySnapshotResponses) {
+  SeatAvailabilitySnapshotResponse resp1{
+      .id = MakeMessageIdentifier(),
       .status_code = 0,
+      .message = {},
+      .identifier = 4013,
+      .sequence = 3,
+      .seat_availability = 38,
   };
-  auto data1 = srpc::Marshal<SeatAvailabilityCallbackResponse>{}(resp1);
-  auto res1 = srpc::Unmarshal<SeatAvailabilityCallbackResponse>{}(data1);
+  auto data1 = srpc::Marshal<SeatAvailabilitySnapshotResponse>{}(resp1);
+  auto res1 = srpc::Unmarshal<SeatAvailabilitySnapshotResponse>{}(data1);
   ASSERT_TRUE(res1.second.has_value());
   // NOLINTBEGIN(bugprone-unchecked-optional-access)
   ASSERT_EQ(resp1.id, res1.second->id);
   ASSERT_EQ(resp1.status_code, res1.second->status_code);
+  ASSERT_EQ(resp1.message, res1.second->message);
+  ASSERT_EQ(resp1.identifier, res1.second->identifier);
+  ASSERT_EQ(resp1.sequence, res1.second->sequence);
+  ASSERT_EQ(resp1.seat_availability, res1.second->seat_availability);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Message, MarshalAndUnmarshalMulticastMonitoringRequests) {
+  MulticastMonitoringRequest req1{
+      .id = MakeMessageIdentifier(),
+      .identifier = 4013,
+      .monitor_interval_sec = 60,
+  };
+  auto data1 = srpc::Marshal<MulticastMonitoringRequest>{}(req1);
+  auto res1 = srpc::Unmarshal<MulticastMonitoringRequest>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.identifier, res1.second->identifier);
+  ASSERT_EQ(req1.monitor_interval_sec, res1.second->monitor_interval_sec);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Message, MarshalAndUnmarshalMulticastMonitoringResponses) {
+  MulticastMonitoringResponse resp1{
+      .id = MakeMessageIdentifier(),
+      .status_code = 0,
+      .message = {},
+      .identifier = 4013,
+      .group = "239.255.77.173",
+      .port = 4013,
+      .monitor_end = 1675612800,
+  };
+  auto data1 = srpc::Marshal<MulticastMonitoringResponse>{}(resp1);
+  auto res1 = srpc::Unmarshal<MulticastMonitoringResponse>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(resp1.id, res1.second->id);
+  ASSERT_EQ(resp1.status_code, res1.second->status_code);
+  ASSERT_EQ(resp1.message, res1.second->message);
+  ASSERT_EQ(resp1.identifier, res1.second->identifier);
+  ASSERT_EQ(resp1.group, res1.second->group);
+  ASSERT_EQ(resp1.port, res1.second->port);
+  ASSERT_EQ(resp1.monitor_end, res1.second->monitor_end);
   // NOLINTEND(bugprone-unchecked-optional-access)
 }
@@ -0,0 +1,42 @@
+#include "messages/timed_request.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/flight_info.h"
+#include "utils/rand.h"
+
+using namespace dfis;
+
+TEST(Message, MarshalAndUnmarshalTimedRequests) {
+  FlightInfoRequest info_req{
+      .id = MakeMessageIdentifier(),
+      .identifier = 4013,
+  };
+  auto info_data = srpc::Marshal<FlightInfoRequest>{}(info_req);
+  TimedRequest req1{
+      .id = info_req.id,
+      .time_budget_ms = 1500,
+      .request = info_data,
+  };
+  auto data1 = srpc::Marshal<TimedRequest>{}(req1);
+  ASSERT_EQ(SerializedSize(req1), data1.size());
+  auto res1 = srpc::Unmarshal<TimedRequest>{}(data1);
+  ASSERT_TRUE(res1.second.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(req1.id, res1.second->id);
+  ASSERT_EQ(req1.time_budget_ms, res1.second->time_budget_ms);
+  ASSERT_EQ(info_data, std::vector<std::byte>(res1.second->request.begin(),
+                                              res1.second->request.end()));
+  auto res2 = srpc::Unmarshal<FlightInfoRequest>{}(res1.second->request);
+  ASSERT_TRUE(res2.second.has_value());
+  ASSERT_EQ(info_req.identifier, res2.second->identifier);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  // A bare request is not mistaken for a timed one.
+  ASSERT_FALSE(srpc::Unmarshal<TimedRequest>{}(info_data).second.has_value());
+}
@@ -0,0 +1,117 @@
+#include "messages/wire.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/flight_search.h"
+#include "messages/id_list.h"
+#include "utils/rand.h"
+
+using namespace dfis;
+
+TEST(Wire, WriteAndReadStringsAndVectors) {
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  writer.Write(std::string{"Singapore"});
+  writer.Write(std::vector<srpc::i32>{4013, 4014, 4015});
+  ASSERT_EQ(writer.Size(), data.size());
+
+  ByteReader reader{data};
+  ASSERT_EQ("Singapore", reader.ReadString());
+  ASSERT_EQ(3, reader.Read<WireLength>());
+  ASSERT_EQ(4013, reader.Read<srpc::i32>());
+  ASSERT_EQ(4014, reader.Read<srpc::i32>());
+  ASSERT_EQ(4015, reader.Read<srpc::i32>());
+  ASSERT_TRUE(reader.Ok());
+  ASSERT_EQ(data.size(), reader.Position());
+}
+
+TEST(Wire, RejectTruncatedStrings) {
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  writer.Write(std::string{"Singapore"});
+  data.pop_back();
+
+  ByteReader reader{data};
+  ASSERT_TRUE(reader.ReadString().empty());
+  ASSERT_FALSE(reader.Ok());
+  ASSERT_EQ(nullptr, reader.Consume(0));
+}
+
+TEST(Wire, ReadInPlace) {
+  std::vector<std::byte> data;
+  ByteWriter writer{data};
+  writer.Write(srpc::i64{1675526400});
+  writer.Write(std::string{"Guangzhou"});
+  writer.Write(srpc::f32{314.15});
+
+  ByteReader reader{data};
+  ASSERT_EQ(1675526400, reader.Read<srpc::i64>());
+  auto source = reader.ReadString();
+  ASSERT_EQ("Guangzhou", source);
+  ASSERT_EQ(reinterpret_cast<const char *>(data.data()) + sizeof(srpc::i64) +
+                sizeof(WireLength),
+            source.data());
+  ASSERT_EQ(srpc::f32{314.15}, reader.Read<srpc::f32>());
+  ASSERT_TRUE(reader.Ok());
+  ASSERT_EQ(data.size(), reader.Position());
+
+  ASSERT_EQ(0, reader.Read<srpc::i32>());
+  ASSERT_FALSE(reader.Ok());
+}
+
+TEST(Wire, MarshalIntoSpans) {
+  FlightSearchRequest req{
+      .id = MakeMessageIdentifier(),
+      .source = "Singapore",
+      .destination = "Tokyo",
+      .encoding = IdListEncoding::kDeltaVarint,
+      .page_size = 0,
+      .cursor = 0,
+  };
+  auto expected = srpc::Marshal<FlightSearchRequest>{}(req);
+
+  std::array<std::byte, 64> buffer{};
+  ByteWriter writer{std::span<std::byte>{buffer}};
+  srpc::Marshal<FlightSearchRequest>{}(req, writer);
+  ASSERT_TRUE(writer.Ok());
+  ASSERT_EQ(expected.size(), writer.Size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin()));
+
+  std::array<std::byte, 16> small{};
+  ByteWriter small_writer{std::span<std::byte>{small}};
+  srpc::Marshal<FlightSearchRequest>{}(req, small_writer);
+  ASSERT_FALSE(small_writer.Ok());
+}
+
+TEST(Wire, ReuseBuffersWithoutReallocating) {
+  FlightSearchRequest req{
+      .id = MakeMessageIdentifier(),
+      .source = "Singapore",
+      .destination = "Tokyo",
+      .encoding = IdListEncoding::kDeltaVarint,
+      .page_size = 0,
+      .cursor = 0,
+  };
+  std::vector<std::byte> buffer;
+  ByteWriter first{buffer};
+  srpc::Marshal<FlightSearchRequest>{}(req, first);
+  const auto *data = buffer.data();
+  auto capacity = buffer.capacity();
+
+  for (int i = 0; i < 100; ++i) {
+    buffer.clear();
+    ByteWriter writer{buffer};
+    srpc::Marshal<FlightSearchRequest>{}(req, writer);
+    ASSERT_EQ(data, buffer.data());
+    ASSERT_EQ(capacity, buffer.capacity());
+  }
+}
@@ -0,0 +1,90 @@
+#include "network/datagram_socket.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/network/tcp_ip.h>
+
+using namespace dfis;
+
+TEST(Network, DatagramSocketSendAndReceive) {
+  std::string error;
+  auto receiver = DatagramSocket::New(0, &error);
+  ASSERT_NE(nullptr, receiver) << error;
+  auto sender = DatagramSocket::New(0, &error);
+  ASSERT_NE(nullptr, sender) << error;
+  ASSERT_NE(0, receiver->Port());
+
+  std::vector<std::byte> data{std::byte{40}, std::byte{13}};
+  srpc::SocketAddress to_addr{
+      .protocol = srpc::kIPv4,
+      .address = "127.0.0.1",
+      .port = receiver->Port(),
+  };
+  auto sent_at = std::chrono::system_clock::now();
+  ASSERT_TRUE(sender->SendTo(to_addr, data, &error)) << error;
+
+  auto datagram = receiver->ReceiveFrom(std::chrono::seconds{1}, &error);
+  ASSERT_TRUE(datagram.has_value()) << error;
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(data, datagram->data);
+  ASSERT_LE(sent_at, datagram->received_at);
+  ASSERT_GE(std::chrono::system_clock::now(), datagram->received_at);
+  ASSERT_EQ(srpc::kIPv4, datagram->from_addr.protocol);
+  ASSERT_EQ("127.0.0.1", datagram->from_addr.address);
+  ASSERT_EQ(sender->Port(), datagram->from_addr.port);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Network, DatagramSocketReceiveTimesOut) {
+  auto socket = DatagramSocket::New();
+  ASSERT_NE(nullptr, socket);
+  std::string error;
+  ASSERT_FALSE(
+      socket->ReceiveFrom(std::chrono::milliseconds{10}, &error).has_value());
+  ASSERT_TRUE(error.empty());
+}
+
+TEST(Network, DatagramSocketResolve) {
+  auto addr = DatagramSocket::Resolve("127.0.0.1", 4013);
+  ASSERT_TRUE(addr.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(srpc::kIPv4, addr->protocol);
+  ASSERT_EQ("127.0.0.1", addr->address);
+  ASSERT_EQ(4013, addr->port);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Network, DatagramSocketMulticastOverLoopback) {
+  std::string error;
+  auto receiver1 = DatagramSocket::NewMulticastReceiver("239.255.77.13", 0,
+                                                        "127.0.0.1", &error);
+  if (receiver1 == nullptr) {
+    GTEST_SKIP() << "Loopback multicast is unavailable: " << error;
+  }
+  auto receiver2 = DatagramSocket::NewMulticastReceiver(
+      "239.255.77.13", receiver1->Port(), "127.0.0.1", &error);
+  ASSERT_NE(nullptr, receiver2) << error;
+  auto sender = DatagramSocket::New(0, &error);
+  ASSERT_NE(nullptr, sender) << error;
+  ASSERT_TRUE(sender->SetMulticastInterface("127.0.0.1", &error)) << error;
+
+  std::vector<std::byte> data{std::byte{40}, std::byte{13}};
+  srpc::SocketAddress to_addr{
+      .protocol = srpc::kIPv4,
+      .address = "239.255.77.13",
+      .port = receiver1->Port(),
+  };
+  ASSERT_TRUE(sender->SendTo(to_addr, data, &error)) << error;
+
+  // A single send reaches every member of the group.
+  for (auto *receiver : {receiver1.get(), receiver2.get()}) {
+    auto datagram = receiver->ReceiveFrom(std::chrono::seconds{1}, &error);
+    ASSERT_TRUE(datagram.has_value()) << error;
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    ASSERT_EQ(data, datagram->data);
+  }
+}
@@ -0,0 +1,110 @@
+#include "network/event_loop.h"
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "network/datagram_socket.h"
+#include "utils/task.h"
+
+using namespace dfis;
+
+TEST(Network, EventLoopRunsInOrder) {
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i) {
+    loop->Post([&order, i] { order.push_back(i); });
+  }
+  loop->Post([&loop] { loop->Stop(); });
+  loop->Post([&order] { order.push_back(3); });
+  loop->Run();
+  // Work posted before stopping is still done.
+  ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), order);
+
+  // The loop can be run again.
+  loop->Post([&order] { order.push_back(4); });
+  loop->Stop();
+  loop->Run();
+  ASSERT_EQ(5, order.size());
+}
+
+TEST(Network, EventLoopRunsTimersInOrder) {
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  std::vector<int> order;
+  loop->RunAfter(std::chrono::milliseconds{20}, [&] {
+    order.push_back(2);
+    loop->Stop();
+  });
+  loop->RunAfter(std::chrono::milliseconds{10},
+                 [&order] { order.push_back(1); });
+  auto cancelled = loop->RunAfter(std::chrono::milliseconds{5},
+                                  [&order] { order.push_back(0); });
+  ASSERT_TRUE(loop->Cancel(cancelled));
+  ASSERT_FALSE(loop->Cancel(cancelled));
+
+  auto start = EventLoop::Clock::now();
+  loop->Run();
+  ASSERT_GE(EventLoop::Clock::now() - start, std::chrono::milliseconds{20});
+  ASSERT_EQ((std::vector<int>{1, 2}), order);
+}
+
+TEST(Network, EventLoopWakesForTimersFromOtherThreads) {
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  std::thread runner{[&loop] { loop->Run(); }};
+  // The loop is waiting with nothing to do; a new timer must wake it.
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  loop->RunAfter(std::chrono::milliseconds{1}, [&loop] { loop->Stop(); });
+  runner.join();
+}
+
+TEST(Network, EventLoopWatchesSockets) {
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  auto receiver = DatagramSocket::New();
+  ASSERT_NE(nullptr, receiver);
+  auto sender = DatagramSocket::New();
+  ASSERT_NE(nullptr, sender);
+  auto to_addr = DatagramSocket::Resolve("127.0.0.1", receiver->Port());
+  ASSERT_TRUE(to_addr.has_value());
+
+  int received = 0;
+  ASSERT_TRUE(loop->Watch(receiver->Fd(), [&] {
+    while (receiver->ReceiveFrom(std::chrono::milliseconds{0}).has_value()) {
+      ++received;
+    }
+    if (received == 2) {
+      loop->Unwatch(receiver->Fd());
+      loop->Stop();
+    }
+  }));
+  std::vector<std::byte> data{std::byte{1}};
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_TRUE(sender->SendTo(*to_addr, data));
+  ASSERT_TRUE(sender->SendTo(*to_addr, data));
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  loop->Run();
+  ASSERT_EQ(2, received);
+}
+
+TEST(Network, EventLoopSchedulesCoroutines) {
+  auto loop = EventLoop::New();
+  ASSERT_NE(nullptr, loop);
+  std::thread runner{[&loop] { loop->Run(); }};
+  auto runner_id = runner.get_id();
+
+  std::thread::id resumed_on;
+  Spawn([](EventLoop &loop, std::thread::id &resumed_on) -> Task<> {
+    co_await loop.Schedule();
+    co_await loop.Sleep(std::chrono::milliseconds{1});
+    resumed_on = std::this_thread::get_id();
+    loop.Stop();
+  }(*loop, resumed_on));
+  runner.join();
+  ASSERT_EQ(runner_id, resumed_on);
+}
@@ -0,0 +1,112 @@
+#include "network/fragmentation.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/fragment.h"
+
+using namespace dfis;
+
+namespace {
+
+std::vector<std::byte> MakeMessage(std::size_t size) {
+  std::vector<std::byte> message(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    message[i] = std::byte(i * 7);
+  }
+  return message;
+}
+
+Fragment Unmarshal(const std::vector<std::byte> &data) {
+  auto res = srpc::Unmarshal<Fragment>{}(data);
+  EXPECT_TRUE(res.second.has_value());
+  return res.second.value_or(Fragment{});
+}
+
+}  // namespace
+
+TEST(Network, SplitIntoFragments) {
+  auto message = MakeMessage(2500);
+  auto fragments = SplitIntoFragments(4013, 1, message, 1000);
+  ASSERT_TRUE(fragments.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(3, fragments->size());
+  std::vector<std::byte> joined;
+  for (std::size_t i = 0; i < fragments->size(); ++i) {
+    auto fragment = Unmarshal((*fragments)[i]);
+    ASSERT_EQ(4013, fragment.request_id);
+    ASSERT_EQ(1, fragment.message_id);
+    ASSERT_EQ(i, fragment.index);
+    ASSERT_EQ(3, fragment.count);
+    ASSERT_LE((*fragments)[i].size(), 1000 + 32);
+    joined.insert(joined.end(), fragment.payload.begin(),
+                  fragment.payload.end());
+  }
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  ASSERT_EQ(message, joined);
+
+  ASSERT_FALSE(SplitIntoFragments(4013, 1, MakeMessage(kMaxFragmentCount + 1),
+                                  1)
+                   .has_value());
+}
+
+TEST(Network, ReassembleFragmentsOutOfOrder) {
+  auto message = MakeMessage(2500);
+  auto fragments = SplitIntoFragments(4013, 1, message, 1000);
+  ASSERT_TRUE(fragments.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  FragmentReassembler reassembler{4013};
+  ASSERT_FALSE(reassembler.Started());
+  ASSERT_FALSE(reassembler.Add(Unmarshal((*fragments)[2])).has_value());
+  ASSERT_TRUE(reassembler.Started());
+  ASSERT_EQ(1, reassembler.MessageId());
+  ASSERT_EQ((std::vector<srpc::u16>{0, 1}), reassembler.Missing());
+  // Duplicates are ignored.
+  ASSERT_FALSE(reassembler.Add(Unmarshal((*fragments)[2])).has_value());
+  ASSERT_FALSE(reassembler.Add(Unmarshal((*fragments)[0])).has_value());
+  ASSERT_EQ(std::vector<srpc::u16>{1}, reassembler.Missing());
+  auto reassembled = reassembler.Add(Unmarshal((*fragments)[1]));
+  ASSERT_TRUE(reassembled.has_value());
+  ASSERT_EQ(message, *reassembled);
+  ASSERT_TRUE(reassembler.Missing().empty());
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Network, ReassembleIgnoresOtherMessages) {
+  auto message = MakeMessage(2000);
+  auto fragments = SplitIntoFragments(4013, 1, message, 1000);
+  auto other_request = SplitIntoFragments(4014, 2, message, 1000);
+  auto other_message = SplitIntoFragments(4013, 3, message, 1000);
+  ASSERT_TRUE(fragments.has_value());
+  ASSERT_TRUE(other_request.has_value());
+  ASSERT_TRUE(other_message.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  FragmentReassembler reassembler{4013};
+  ASSERT_FALSE(reassembler.Add(Unmarshal((*other_request)[0])).has_value());
+  ASSERT_FALSE(reassembler.Started());
+  ASSERT_FALSE(reassembler.Add(Unmarshal((*fragments)[0])).has_value());
+  ASSERT_FALSE(reassembler.Add(Unmarshal((*other_message)[1])).has_value());
+  ASSERT_EQ(std::vector<srpc::u16>{1}, reassembler.Missing());
+  ASSERT_TRUE(reassembler.Add(Unmarshal((*fragments)[1])).has_value());
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Network, SentFragmentsEvictOldest) {
+  SentFragments sent{2};
+  sent.Add(1, {{std::byte{1}}});
+  sent.Add(2, {{std::byte{2}}, {std::byte{3}}});
+  ASSERT_NE(nullptr, sent.Find(1, 0));
+  ASSERT_EQ(nullptr, sent.Find(1, 1));
+  ASSERT_EQ(std::vector<std::byte>{std::byte{3}}, *sent.Find(2, 1));
+
+  sent.Add(3, {{std::byte{4}}});
+  ASSERT_EQ(2, sent.Size());
+  ASSERT_EQ(nullptr, sent.Find(1, 0));
+  ASSERT_NE(nullptr, sent.Find(2, 0));
+  ASSERT_NE(nullptr, sent.Find(3, 0));
+}
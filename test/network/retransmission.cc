@@ -0,0 +1,91 @@
+#include "network/retransmission.h"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace dfis;
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+TEST(Network, RttEstimatorBacksOff) {
+  RttEstimator rtt{seconds{1}, milliseconds{50}, seconds{8}};
+  ASSERT_FALSE(rtt.SmoothedRtt().has_value());
+  ASSERT_EQ(seconds{1}, rtt.Timeout());
+  ASSERT_EQ(seconds{2}, rtt.Timeout(1));
+  ASSERT_EQ(seconds{4}, rtt.Timeout(2));
+  ASSERT_EQ(seconds{8}, rtt.Timeout(3));
+  ASSERT_EQ(seconds{8}, rtt.Timeout(100));
+}
+
+TEST(Network, RttEstimatorFollowsSamples) {
+  RttEstimator rtt{seconds{1}, milliseconds{50}, seconds{8}};
+  // The first sample sets the variation to half of it.
+  rtt.Sample(milliseconds{100});
+  ASSERT_EQ(milliseconds{100}, rtt.SmoothedRtt());
+  ASSERT_EQ(milliseconds{300}, rtt.Timeout());
+  // Steady samples shrink the variation by a quarter each time.
+  rtt.Sample(milliseconds{100});
+  ASSERT_EQ(milliseconds{100}, rtt.SmoothedRtt());
+  ASSERT_EQ(milliseconds{250}, rtt.Timeout());
+  // A spike raises both.
+  rtt.Sample(milliseconds{900});
+  ASSERT_EQ(milliseconds{200}, rtt.SmoothedRtt());
+  ASSERT_EQ(microseconds{200000 + 4 * 228125}, rtt.Timeout());
+}
+
+TEST(Network, RttEstimatorKeepsBackoff) {
+  RttEstimator rtt{seconds{1}, milliseconds{50}, seconds{8}};
+  for (int i = 0; i < 100; ++i) {
+    rtt.Sample(milliseconds{1});
+  }
+  ASSERT_EQ(milliseconds{50}, rtt.Timeout());
+  // Requests that waited the same timeout back it off once between them.
+  rtt.OnTimeout(milliseconds{50});
+  rtt.OnTimeout(milliseconds{50});
+  ASSERT_EQ(milliseconds{100}, rtt.Timeout());
+  ASSERT_EQ(milliseconds{200}, rtt.Timeout(1));
+  rtt.OnTimeout(milliseconds{100});
+  ASSERT_EQ(milliseconds{200}, rtt.Timeout());
+  for (int i = 0; i < 10; ++i) {
+    rtt.OnTimeout(rtt.Timeout());
+  }
+  ASSERT_EQ(seconds{8}, rtt.Timeout());
+  // The next sample sets the timeout afresh.
+  rtt.Sample(milliseconds{1});
+  ASSERT_EQ(milliseconds{50}, rtt.Timeout());
+}
+
+TEST(Network, RttEstimatorClampsTimeouts) {
+  RttEstimator rtt{seconds{1}, milliseconds{50}, seconds{8}};
+  for (int i = 0; i < 100; ++i) {
+    rtt.Sample(milliseconds{1});
+  }
+  ASSERT_EQ(milliseconds{50}, rtt.Timeout());
+  rtt.Sample(seconds{60});
+  ASSERT_EQ(seconds{8}, rtt.Timeout());
+  ASSERT_EQ(seconds{8}, RttEstimator(seconds{60}, milliseconds{50}, seconds{8})
+                            .Timeout());
+}
+
+TEST(Network, RetryBudgetLimitsRetries) {
+  RetryBudget budget{10, 0.1};
+  int retries = 0;
+  while (budget.TryRetry()) {
+    ++retries;
+  }
+  ASSERT_EQ(5, retries);
+  // Each retry must then be earned by ten responses.
+  for (int i = 0; i < 10; ++i) {
+    budget.OnSuccess();
+  }
+  ASSERT_TRUE(budget.TryRetry());
+  ASSERT_FALSE(budget.TryRetry());
+  // Tokens never exceed the maximum.
+  for (int i = 0; i < 1000; ++i) {
+    budget.OnSuccess();
+  }
+  ASSERT_DOUBLE_EQ(10, budget.Tokens());
+}
@@ -0,0 +1,84 @@
+#include "server/callback_dispatcher.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <srpc/network/tcp_ip.h>
+
+#include "messages/seat_availability.h"
+
+using namespace dfis;
+
+namespace {
+
+const srpc::SocketAddress kAddr{
+    .protocol = srpc::kIPv4,
+    .address = "127.0.0.1",
+    .port = 4013,
+};
+
+}  // namespace
+
+TEST(Server, CallbackDispatcherDeliversCallbacks) {
+  std::atomic<int> sum = 0;
+  {
+    CallbackDispatcher dispatcher{
+        4, 128,
+        [&sum](const srpc::SocketAddress & /*to_addr*/,
+               SeatAvailabilityCallbackRequest req) {
+          sum += req.seat_availability;
+        }};
+    for (int i = 1; i <= 100; ++i) {
+      ASSERT_TRUE(dispatcher.Dispatch(kAddr, SeatAvailabilityCallbackRequest{
+                                                 .id = 0,
+                                                 .subscription = 1,
+                                                 .identifier = 4013,
+                                                 .sequence = 0,
+                                                 .seat_availability = i,
+                                             }));
+    }
+    while (dispatcher.Metrics().completed < 100) {
+      std::this_thread::yield();
+    }
+    auto metrics = dispatcher.Metrics();
+    ASSERT_EQ(100, metrics.dispatched);
+    ASSERT_EQ(0, metrics.dropped);
+    ASSERT_EQ(0, metrics.queued);
+  }
+  ASSERT_EQ(5050, sum);
+}
+
+TEST(Server, CallbackDispatcherDropsWhenFull) {
+  std::promise<void> started;
+  std::promise<void> gate;
+  auto gate_future = gate.get_future().share();
+  std::atomic<bool> first = true;
+  CallbackDispatcher dispatcher{
+      1, 1,
+      [&](const srpc::SocketAddress & /*to_addr*/,
+          SeatAvailabilityCallbackRequest /*req*/) {
+        if (first.exchange(false)) {
+          started.set_value();
+        }
+        gate_future.wait();
+      }};
+  SeatAvailabilityCallbackRequest req{
+      .id = 0,
+      .subscription = 1,
+      .identifier = 4013,
+      .sequence = 1,
+      .seat_availability = 42,
+  };
+  ASSERT_TRUE(dispatcher.Dispatch(kAddr, req));
+  started.get_future().wait();
+  ASSERT_TRUE(dispatcher.Dispatch(kAddr, req));
+  ASSERT_FALSE(dispatcher.Dispatch(kAddr, req));
+  gate.set_value();
+
+  auto metrics = dispatcher.Metrics();
+  ASSERT_EQ(2, metrics.dispatched);
+  ASSERT_EQ(1, metrics.dropped);
+  ASSERT_EQ(1, metrics.max_queued);
+}
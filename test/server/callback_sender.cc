@@ -0,0 +1,51 @@
+#include "server/callback_sender.h"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/seat_availability.h"
+#include "network/datagram_socket.h"
+
+using namespace dfis;
+
+TEST(Server, CallbackSenderSendsWithoutWaiting) {
+  std::string error;
+  auto sender = CallbackSender::New(&error);
+  ASSERT_NE(nullptr, sender) << error;
+  auto monitor = DatagramSocket::New(0, &error);
+  ASSERT_NE(nullptr, monitor) << error;
+
+  srpc::SocketAddress to_addr{
+      .protocol = srpc::kIPv4,
+      .address = "127.0.0.1",
+      .port = monitor->Port(),
+  };
+  for (srpc::u64 sequence = 1; sequence <= 2; ++sequence) {
+    ASSERT_TRUE(sender->Send(to_addr,
+                             SeatAvailabilityCallbackRequest{
+                                 .id = 4013,
+                                 .subscription = 1,
+                                 .identifier = 4012,
+                                 .sequence = sequence,
+                                 .seat_availability = 42,
+                             },
+                             &error))
+        << error;
+  }
+
+  for (srpc::u64 sequence = 1; sequence <= 2; ++sequence) {
+    auto datagram = monitor->ReceiveFrom(std::chrono::seconds{1}, &error);
+    ASSERT_TRUE(datagram.has_value()) << error;
+    // NOLINTBEGIN(bugprone-unchecked-optional-access)
+    auto req_res =
+        srpc::Unmarshal<SeatAvailabilityCallbackRequest>{}(datagram->data);
+    ASSERT_TRUE(req_res.second.has_value());
+    ASSERT_EQ(sequence, req_res.second->sequence);
+    ASSERT_EQ(4012, req_res.second->identifier);
+    // NOLINTEND(bugprone-unchecked-optional-access)
+  }
+}
@@ -0,0 +1,133 @@
+#include "server/flight_store.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+
+#include "messages/flight.h"
+
+using namespace dfis;
+
+namespace {
+
+std::vector<Flight> MakeFlights() {
+  return {
+      Flight{
+          .identifier = 4013,
+          .source = "Guangzhou",
+          .destination = "Singapore",
+          .departure_time = 1675526400,
+          .airfare = 314.15,
+          .seat_availability = 42,
+      },
+      Flight{
+          .identifier = 4012,
+          .source = "Singapore",
+          .destination = "Guangzhou",
+          .departure_time = 1675612800,
+          .airfare = 271.83,
+          .seat_availability = 0,
+      },
+  };
+}
+
+}  // namespace
+
+TEST(Server, FlightStoreFindAndGet) {
+  auto flights = MakeFlights();
+  FlightStore store{flights};
+  ASSERT_EQ(2, store.Size());
+  ASSERT_FALSE(store.Find(4011).has_value());
+
+  auto slot = store.Find(4013);
+  ASSERT_TRUE(slot.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(flights[0], store.Get(*slot));
+  ASSERT_EQ(flights[0].airfare, store.Schedule(*slot).airfare);
+  ASSERT_EQ(42, store.SeatAvailability(*slot));
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Server, FlightStoreReserveAndRelease) {
+  FlightStore store{MakeFlights()};
+  auto slot = store.Find(4013);
+  ASSERT_TRUE(slot.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(40, store.Reserve(*slot, 2));
+  ASSERT_FALSE(store.Reserve(*slot, 41).has_value());
+  ASSERT_EQ(0, store.Reserve(*slot, 40));
+  ASSERT_EQ(3, store.Release(*slot, 3));
+  ASSERT_EQ(3, store.SeatAvailability(*slot));
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Server, FlightStoreIndexesRoutes) {
+  auto flights = MakeFlights();
+  flights.push_back(Flight{
+      .identifier = 4011,
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_time = 1675526400,
+      .airfare = 161.80,
+      .seat_availability = 7,
+  });
+  FlightStore store{flights};
+  std::vector<srpc::i32> identifiers;
+  for (auto slot : store.RouteSlots(RouteRef{"Singapore", "Guangzhou"})) {
+    identifiers.push_back(store.Schedule(slot).identifier);
+  }
+  // Ordered by departure time.
+  ASSERT_EQ((std::vector<srpc::i32>{4011, 4012}), identifiers);
+  ASSERT_TRUE(store.RouteSlots(RouteRef{"Singapore", "Kunming"}).empty());
+}
+
+TEST(Server, FlightStoreIndexesRouteIdentifiers) {
+  auto flights = MakeFlights();
+  flights.push_back(Flight{
+      .identifier = 4011,
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_time = 1675699200,
+      .airfare = 161.80,
+      .seat_availability = 7,
+  });
+  FlightStore store{flights};
+  auto identifiers = store.RouteIdentifiers(RouteRef{"Singapore", "Guangzhou"});
+  ASSERT_EQ((std::vector<srpc::i32>{4011, 4012}),
+            std::vector<srpc::i32>(identifiers.begin(), identifiers.end()));
+  ASSERT_TRUE(store.RouteIdentifiers(RouteRef{"Singapore", "Kunming"}).empty());
+}
+
+TEST(Server, FlightStoreIndexesFares) {
+  auto flights = MakeFlights();
+  flights.push_back(Flight{
+      .identifier = 4011,
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_time = 1675699200,
+      .airfare = 271.83,
+      .seat_availability = 7,
+  });
+  FlightStore store{flights};
+  std::vector<srpc::i32> identifiers;
+  for (auto slot : store.FareSlots()) {
+    identifiers.push_back(store.Schedule(slot).identifier);
+  }
+  // Ordered by airfare, and then by identifier.
+  ASSERT_EQ((std::vector<srpc::i32>{4011, 4012, 4013}), identifiers);
+
+  using Range = std::pair<std::size_t, std::size_t>;
+  ASSERT_EQ(Range(0, 3), store.FareRange(0, 1000));
+  ASSERT_EQ(Range(0, 2), store.FareRange(271.83F, 300));
+  ASSERT_EQ(Range(2, 3), store.FareRange(300, 314.15F));
+  ASSERT_EQ(Range(3, 3), store.FareRange(400, 500));
+  ASSERT_EQ(0, store.FareRange(300, 200).second);
+}
+
+TEST(Server, FlightStoreCountersArePadded) {
+  ASSERT_EQ(kCacheLineSize, sizeof(SeatCounter));
+  ASSERT_EQ(kCacheLineSize, alignof(SeatCounter));
+}
@@ -0,0 +1,62 @@
+#include "server/multicast_publisher.h"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <srpc/types/integers.h>
+#include <srpc/types/serialization.h>
+
+#include "messages/seat_availability.h"
+#include "network/datagram_socket.h"
+
+using namespace dfis;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+}  // namespace
+
+TEST(Server, MulticastPublisherGroupsFlights) {
+  ASSERT_EQ("239.255.77.173", MulticastPublisher::Group(4013));
+  ASSERT_EQ(MulticastPublisher::Group(4013),
+            MulticastPublisher::Group(4013 + kMulticastGroups));
+  ASSERT_NE(MulticastPublisher::Group(4013), MulticastPublisher::Group(4012));
+}
+
+TEST(Server, MulticastPublisherSendsToGroupOverLoopback) {
+  std::string error;
+  auto receiver = DatagramSocket::NewMulticastReceiver(
+      MulticastPublisher::Group(4013), 0, "127.0.0.1", &error);
+  if (receiver == nullptr) {
+    GTEST_SKIP() << "Loopback multicast is unavailable: " << error;
+  }
+  auto publisher =
+      MulticastPublisher::New(receiver->Port(), "127.0.0.1", &error);
+  ASSERT_NE(nullptr, publisher) << error;
+
+  // Not monitored yet, or no longer.
+  ASSERT_FALSE(publisher->Publish(4013, 42));
+  publisher->Enable(4012, Clock::now() - std::chrono::seconds{1});
+  ASSERT_FALSE(publisher->Publish(4012, 42));
+
+  publisher->Enable(4013, Clock::now() + std::chrono::seconds{60});
+  for (srpc::i32 seats = 42; seats > 40; --seats) {
+    ASSERT_TRUE(publisher->Publish(4013, seats, &error)) << error;
+  }
+  for (srpc::u64 sequence = 1; sequence <= 2; ++sequence) {
+    auto datagram = receiver->ReceiveFrom(std::chrono::seconds{1}, &error);
+    ASSERT_TRUE(datagram.has_value()) << error;
+    // NOLINTBEGIN(bugprone-unchecked-optional-access)
+    auto req_res =
+        srpc::Unmarshal<SeatAvailabilityCallbackRequest>{}(datagram->data);
+    ASSERT_TRUE(req_res.second.has_value());
+    ASSERT_EQ(0, req_res.second->subscription);
+    ASSERT_EQ(4013, req_res.second->identifier);
+    ASSERT_EQ(sequence, req_res.second->sequence);
+    ASSERT_EQ(43 - static_cast<srpc::i32>(sequence),
+              req_res.second->seat_availability);
+    // NOLINTEND(bugprone-unchecked-optional-access)
+  }
+}
@@ -0,0 +1,245 @@
+#include "server/notifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+#include "messages/seat_availability.h"
+#include "server/callback_dispatcher.h"
+#include "server/flight_store.h"
+#include "server/subscriptions.h"
+
+using namespace dfis;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+const srpc::SocketAddress kAddr{
+    .protocol = srpc::kIPv4,
+    .address = "127.0.0.1",
+    .port = 4013,
+};
+
+SubscriptionOptions MakeOptions(
+    int coalesce_window_ms,
+    SeatAvailabilityTrigger trigger = SeatAvailabilityTrigger::kEveryChange,
+    srpc::i32 threshold = 0) {
+  return {
+      .coalesce_window = std::chrono::milliseconds{coalesce_window_ms},
+      .trigger = trigger,
+      .threshold = threshold,
+  };
+}
+
+FlightSchedule MakeSchedule(srpc::i32 identifier) {
+  return {
+      .identifier = identifier,
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_time = 1675526400,
+      .airfare = 271.83,
+  };
+}
+
+class Recorder {
+ public:
+  CallbackDispatcher::Handler Handler() {
+    return [this](const srpc::SocketAddress & /*to_addr*/,
+                  SeatAvailabilityCallbackRequest req) {
+      std::lock_guard lock{mutex_};
+      seats_.push_back(req.seat_availability);
+      sequences_.push_back(req.sequence);
+    };
+  }
+
+  std::vector<srpc::u64> Sequences() {
+    std::lock_guard lock{mutex_};
+    return sequences_;
+  }
+
+  std::vector<srpc::i32> WaitFor(std::size_t count) {
+    auto deadline = Clock::now() + std::chrono::seconds{5};
+    for (;;) {
+      {
+        std::lock_guard lock{mutex_};
+        if (seats_.size() >= count || Clock::now() > deadline) {
+          return seats_;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<srpc::i32> seats_;
+  std::vector<srpc::u64> sequences_;
+};
+
+}  // namespace
+
+TEST(Server, NotifierSendsEveryUpdateWithoutWindow) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  notifier.Subscribe(4013, kAddr, Clock::now() + std::chrono::seconds{60},
+                     MakeOptions(0), 10);
+  for (srpc::i32 seats = 10; seats > 7; --seats) {
+    auto result = notifier.Publish(MakeSchedule(4013), seats);
+    ASSERT_EQ(1, result.sent);
+    ASSERT_EQ(0, result.coalesced);
+  }
+  ASSERT_EQ((std::vector<srpc::i32>{10, 9, 8}), recorder.WaitFor(3));
+}
+
+TEST(Server, NotifierCoalescesBursts) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  notifier.Subscribe(4013, kAddr, Clock::now() + std::chrono::seconds{60},
+                     MakeOptions(200), 10);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 10).sent);
+  for (srpc::i32 seats = 9; seats > 0; --seats) {
+    ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), seats).coalesced);
+  }
+  ASSERT_EQ(0, notifier.Publish(MakeSchedule(4012), 0).sent);
+  ASSERT_EQ((std::vector<srpc::i32>{10, 1}), recorder.WaitFor(2));
+}
+
+TEST(Server, NotifierSkipsExpiredSubscriptions) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  notifier.Subscribe(4013, kAddr, Clock::now() - std::chrono::seconds{1},
+                     MakeOptions(0), 10);
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  ASSERT_EQ(0, notifier.Publish(MakeSchedule(4013), 10).sent);
+}
+
+TEST(Server, NotifierEvaluatesTriggers) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  auto monitor_end = Clock::now() + std::chrono::seconds{60};
+  notifier.Subscribe(
+      4013, kAddr, monitor_end,
+      MakeOptions(0, SeatAvailabilityTrigger::kFallsBelow, 5), 10);
+  notifier.Subscribe(4013, kAddr, monitor_end,
+                     MakeOptions(0, SeatAvailabilityTrigger::kRisesTo, 1), 10);
+  notifier.Subscribe(4013, kAddr, monitor_end,
+                     MakeOptions(0, SeatAvailabilityTrigger::kCrosses, 5), 10);
+
+  for (srpc::i32 seats : {9, 6, 4, 3, 0, 2, 5, 7}) {
+    static_cast<void>(notifier.Publish(MakeSchedule(4013), seats));
+  }
+  auto seats = recorder.WaitFor(4);
+  std::sort(seats.begin(), seats.end());
+  // Falls below 5 at 4; rises to 1 at 2; crosses 5 at 4 and at 5.
+  ASSERT_EQ((std::vector<srpc::i32>{2, 4, 4, 5}), seats);
+}
+
+TEST(Server, NotifierHoldsBackLatestTriggeredUpdate) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  auto id = notifier.Subscribe(
+      4013, kAddr, Clock::now() + std::chrono::seconds{60},
+      MakeOptions(200, SeatAvailabilityTrigger::kFallsBelow, 10), 20);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 9).sent);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 12).filtered);
+  // Falls below again within the window, and rebounds before it closes.
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 9).coalesced);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 15).filtered);
+  // Falls once more; the update sent carries the latest availability.
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 8).coalesced);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 6).coalesced);
+  ASSERT_EQ((std::vector<srpc::i32>{9, 6}), recorder.WaitFor(2));
+  auto snapshot = notifier.Snapshot(id, 4013);
+  ASSERT_TRUE(snapshot.has_value());
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  ASSERT_EQ(6, snapshot->seat_availability);
+}
+
+TEST(Server, NotifierDropsUndoneCrossings) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  auto id = notifier.Subscribe(
+      4013, kAddr, Clock::now() + std::chrono::seconds{60},
+      MakeOptions(50, SeatAvailabilityTrigger::kCrosses, 10), 20);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 9).sent);
+  // Crosses back up and down again within the window: no net change.
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 15).coalesced);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 8).filtered);
+  std::this_thread::sleep_for(std::chrono::milliseconds{200});
+  ASSERT_EQ(std::vector<srpc::i32>{9}, recorder.WaitFor(1));
+  auto snapshot = notifier.Snapshot(id, 4013);
+  ASSERT_TRUE(snapshot.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(1, snapshot->sequence);
+  ASSERT_EQ(9, snapshot->seat_availability);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+}
+
+TEST(Server, NotifierNumbersUpdates) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  auto id =
+      notifier.Subscribe(4013, kAddr, Clock::now() + std::chrono::seconds{60},
+                         MakeOptions(0), 10);
+  auto snapshot = notifier.Snapshot(id, 4013);
+  ASSERT_TRUE(snapshot.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(0, snapshot->sequence);
+  ASSERT_EQ(10, snapshot->seat_availability);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 9).sent);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 8).sent);
+  ASSERT_EQ((std::vector<srpc::i32>{9, 8}), recorder.WaitFor(2));
+  ASSERT_EQ((std::vector<srpc::u64>{1, 2}), recorder.Sequences());
+  snapshot = notifier.Snapshot(id, 4013);
+  ASSERT_TRUE(snapshot.has_value());
+  // NOLINTBEGIN(bugprone-unchecked-optional-access)
+  ASSERT_EQ(2, snapshot->sequence);
+  ASSERT_EQ(8, snapshot->seat_availability);
+  // NOLINTEND(bugprone-unchecked-optional-access)
+  ASSERT_FALSE(notifier.Snapshot(id, 4012).has_value());
+  ASSERT_FALSE(notifier.Snapshot(id + 1, 4013).has_value());
+}
+
+TEST(Server, NotifierFansOutRouteSubscriptions) {
+  Recorder recorder;
+  CallbackDispatcher dispatcher{1, 16, recorder.Handler()};
+  Notifier notifier{dispatcher};
+  std::vector<std::pair<srpc::i32, srpc::i32>> seat_availability{{4012, 3},
+                                                                 {4013, 10}};
+  notifier.Subscribe(
+      RouteFilter{
+          .route = {"Singapore", "Guangzhou"},
+          .departure_from = 0,
+          .departure_to = 0,
+      },
+      kAddr, Clock::now() + std::chrono::seconds{60},
+      MakeOptions(0, SeatAvailabilityTrigger::kFallsBelow, 5),
+      seat_availability);
+
+  // 4012 is already below the threshold; 4013 falls below it.
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4012), 2).filtered);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 6).filtered);
+  ASSERT_EQ(1, notifier.Publish(MakeSchedule(4013), 4).sent);
+  auto other_route = MakeSchedule(4011);
+  other_route.destination = "Kunming";
+  auto result = notifier.Publish(other_route, 0);
+  ASSERT_EQ(0, result.sent + result.filtered);
+  ASSERT_EQ(std::vector<srpc::i32>{4}, recorder.WaitFor(1));
+}
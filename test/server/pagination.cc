@@ -0,0 +1,47 @@
+#include "server/pagination.h"
+
+#include <gtest/gtest.h>
+
+using namespace dfis;
+
+TEST(Server, SelectPagesInTurn) {
+  auto page1 = SelectPage(0, 5, 0, 2);
+  ASSERT_EQ(0, page1.begin);
+  ASSERT_EQ(2, page1.end);
+  ASSERT_EQ(2, page1.next_cursor);
+
+  auto page2 = SelectPage(0, 5, page1.next_cursor, 2);
+  ASSERT_EQ(2, page2.begin);
+  ASSERT_EQ(4, page2.end);
+  ASSERT_EQ(4, page2.next_cursor);
+
+  auto page3 = SelectPage(0, 5, page2.next_cursor, 2);
+  ASSERT_EQ(4, page3.begin);
+  ASSERT_EQ(5, page3.end);
+  ASSERT_EQ(0, page3.next_cursor);
+}
+
+TEST(Server, SelectAllResultsWithoutPageSize) {
+  auto page = SelectPage(3, 8, 0, 0);
+  ASSERT_EQ(3, page.begin);
+  ASSERT_EQ(8, page.end);
+  ASSERT_EQ(0, page.next_cursor);
+}
+
+TEST(Server, SelectPageClampsCursors) {
+  // The first page of results in the middle of an index.
+  auto page1 = SelectPage(3, 8, 0, 4);
+  ASSERT_EQ(3, page1.begin);
+  ASSERT_EQ(7, page1.end);
+  ASSERT_EQ(7, page1.next_cursor);
+
+  auto page2 = SelectPage(3, 8, 100, 4);
+  ASSERT_EQ(8, page2.begin);
+  ASSERT_EQ(8, page2.end);
+  ASSERT_EQ(0, page2.next_cursor);
+
+  auto empty = SelectPage(0, 0, 0, 4);
+  ASSERT_EQ(0, empty.begin);
+  ASSERT_EQ(0, empty.end);
+  ASSERT_EQ(0, empty.next_cursor);
+}
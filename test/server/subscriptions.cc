@@ -0,0 +1,149 @@
+#include "server/subscriptions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <srpc/network/tcp_ip.h>
+#include <srpc/types/integers.h>
+
+#include "messages/seat_availability.h"
+#include "server/flight_store.h"
+
+using namespace dfis;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+Subscription MakeSubscription(std::variant<srpc::i32, RouteFilter> topic,
+                              srpc::u16 port, Clock::time_point monitor_end) {
+  return {
+      .id = 0,
+      .topic = std::move(topic),
+      .to_addr =
+          {
+              .protocol = srpc::kIPv4,
+              .address = "127.0.0.1",
+              .port = port,
+          },
+      .monitor_end = monitor_end,
+      .options =
+          {
+              .coalesce_window = {},
+              .trigger = SeatAvailabilityTrigger::kEveryChange,
+              .threshold = 0,
+          },
+      .flights = {},
+  };
+}
+
+FlightSchedule MakeSchedule(srpc::i32 identifier,
+                            srpc::i64 departure_time = 1675526400) {
+  return {
+      .identifier = identifier,
+      .source = "Singapore",
+      .destination = "Guangzhou",
+      .departure_time = departure_time,
+      .airfare = 271.83,
+  };
+}
+
+std::vector<srpc::u16> Ports(SubscriptionTable &subscriptions,
+                             const FlightSchedule &schedule) {
+  std::vector<srpc::u16> ports;
+  subscriptions.ForEach(schedule, [&ports](const auto &subscription) {
+    ports.push_back(subscription.to_addr.port);
+  });
+  std::sort(ports.begin(), ports.end());
+  return ports;
+}
+
+std::vector<srpc::u16> Ports(SubscriptionTable &subscriptions,
+                             srpc::i32 identifier) {
+  return Ports(subscriptions, MakeSchedule(identifier));
+}
+
+}  // namespace
+
+TEST(Server, SubscriptionsExpire) {
+  auto start = Clock::now();
+  SubscriptionTable subscriptions{start};
+  subscriptions.Add(
+      MakeSubscription(4013, 1, start + std::chrono::seconds{10}));
+  subscriptions.Add(
+      MakeSubscription(4013, 2, start + std::chrono::seconds{20}));
+  subscriptions.Add(
+      MakeSubscription(4013, 3, start + std::chrono::seconds{30}));
+  subscriptions.Add(
+      MakeSubscription(4012, 4, start + std::chrono::seconds{10}));
+  ASSERT_EQ(4, subscriptions.Size());
+  ASSERT_EQ((std::vector<srpc::u16>{1, 2, 3}), Ports(subscriptions, 4013));
+
+  ASSERT_EQ(0, subscriptions.Expire(start + std::chrono::seconds{5}));
+  ASSERT_EQ(2, subscriptions.Expire(start + std::chrono::seconds{10}));
+  ASSERT_EQ((std::vector<srpc::u16>{2, 3}), Ports(subscriptions, 4013));
+  ASSERT_EQ(std::vector<srpc::u16>{}, Ports(subscriptions, 4012));
+
+  ASSERT_EQ(1, subscriptions.Expire(start + std::chrono::seconds{25}));
+  ASSERT_EQ(std::vector<srpc::u16>{3}, Ports(subscriptions, 4013));
+  ASSERT_EQ(1, subscriptions.Size());
+}
+
+TEST(Server, SubscriptionsFind) {
+  auto start = Clock::now();
+  SubscriptionTable subscriptions{start};
+  auto id1 = subscriptions.Add(
+      MakeSubscription(4013, 1, start + std::chrono::seconds{10}));
+  auto id2 = subscriptions.Add(
+      MakeSubscription(4013, 2, start + std::chrono::seconds{20}));
+  ASSERT_NE(id1, id2);
+  ASSERT_NE(nullptr, subscriptions.Find(id1));
+  ASSERT_EQ(2, subscriptions.Find(id2)->to_addr.port);
+
+  subscriptions.Expire(start + std::chrono::seconds{10});
+  ASSERT_EQ(nullptr, subscriptions.Find(id1));
+  ASSERT_EQ(id2, subscriptions.Find(id2)->id);
+}
+
+TEST(Server, SubscriptionsMatchRoutes) {
+  auto start = Clock::now();
+  SubscriptionTable subscriptions{start};
+  subscriptions.Add(MakeSubscription(
+      RouteFilter{
+          .route = {"Singapore", "Guangzhou"},
+          .departure_from = 0,
+          .departure_to = 0,
+      },
+      1, start + std::chrono::seconds{10}));
+  subscriptions.Add(MakeSubscription(
+      RouteFilter{
+          .route = {"Singapore", "Guangzhou"},
+          .departure_from = 1675526400,
+          .departure_to = 1675612800,
+      },
+      2, start + std::chrono::seconds{20}));
+  subscriptions.Add(MakeSubscription(
+      RouteFilter{
+          .route = {"Guangzhou", "Singapore"},
+          .departure_from = 0,
+          .departure_to = 0,
+      },
+      3, start + std::chrono::seconds{20}));
+  subscriptions.Add(
+      MakeSubscription(4013, 4, start + std::chrono::seconds{20}));
+
+  ASSERT_EQ((std::vector<srpc::u16>{1, 2, 4}),
+            Ports(subscriptions, MakeSchedule(4013, 1675526400)));
+  ASSERT_EQ((std::vector<srpc::u16>{1}),
+            Ports(subscriptions, MakeSchedule(4012, 1675699200)));
+
+  ASSERT_EQ(1, subscriptions.Expire(start + std::chrono::seconds{10}));
+  ASSERT_EQ(std::vector<srpc::u16>{},
+            Ports(subscriptions, MakeSchedule(4012, 1675699200)));
+  ASSERT_EQ(3, subscriptions.Expire(start + std::chrono::seconds{20}));
+  ASSERT_EQ(0, subscriptions.Size());
+}
@@ -0,0 +1,67 @@
+#include "server/timer_wheel.h"
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace dfis;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+std::vector<int> AdvanceTo(TimerWheel<int> &wheel, Clock::time_point now) {
+  std::vector<int> expired;
+  wheel.Advance(now, [&expired](int value) { expired.push_back(value); });
+  return expired;
+}
+
+}  // namespace
+
+TEST(Server, TimerWheelExpiresInOrder) {
+  auto start = Clock::now();
+  TimerWheel<int> wheel{std::chrono::seconds{1}, start};
+  wheel.Schedule(start + std::chrono::seconds{3}, 3);
+  wheel.Schedule(start + std::chrono::seconds{1}, 1);
+  wheel.Schedule(start + std::chrono::milliseconds{1500}, 2);
+  ASSERT_EQ(3, wheel.Size());
+
+  ASSERT_EQ(std::vector<int>{}, AdvanceTo(wheel, start));
+  ASSERT_EQ(std::vector<int>{1},
+            AdvanceTo(wheel, start + std::chrono::seconds{1}));
+  ASSERT_EQ(std::vector<int>{},
+            AdvanceTo(wheel, start + std::chrono::milliseconds{1900}));
+  ASSERT_EQ(std::vector<int>{2},
+            AdvanceTo(wheel, start + std::chrono::seconds{2}));
+  ASSERT_EQ(std::vector<int>{3},
+            AdvanceTo(wheel, start + std::chrono::seconds{10}));
+  ASSERT_EQ(0, wheel.Size());
+}
+
+TEST(Server, TimerWheelCascadesAcrossLevels) {
+  auto start = Clock::now();
+  TimerWheel<int> wheel{std::chrono::seconds{1}, start};
+  // One timer per level, plus one beyond the range of the wheel.
+  const std::vector<int> delays{50, 100, 5000, 300000, 20000000};
+  for (auto delay : delays) {
+    wheel.Schedule(start + std::chrono::seconds{delay}, delay);
+  }
+  for (auto delay : delays) {
+    ASSERT_EQ(std::vector<int>{},
+              AdvanceTo(wheel, start + std::chrono::seconds{delay - 1}));
+    ASSERT_EQ(std::vector<int>{delay},
+              AdvanceTo(wheel, start + std::chrono::seconds{delay}));
+  }
+  ASSERT_EQ(0, wheel.Size());
+}
+
+TEST(Server, TimerWheelFiresOverdueTimers) {
+  auto start = Clock::now();
+  TimerWheel<int> wheel{std::chrono::seconds{1}, start};
+  ASSERT_EQ(std::vector<int>{},
+            AdvanceTo(wheel, start + std::chrono::seconds{100}));
+  wheel.Schedule(start, 42);
+  ASSERT_EQ(std::vector<int>{42},
+            AdvanceTo(wheel, start + std::chrono::seconds{101}));
+}
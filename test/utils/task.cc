@@ -0,0 +1,34 @@
+#include "utils/task.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+using namespace dfis;
+
+namespace {
+
+Task<int> Add(int a, int b) { co_return a + b; }
+
+Task<std::unique_ptr<std::string>> Greet(std::string name) {
+  auto sum = co_await Add(1, 2);
+  co_return std::make_unique<std::string>(name + std::to_string(sum));
+}
+
+Task<> Store(std::string &out) {
+  auto greeting = co_await Greet("dfis");
+  out = std::move(*greeting);
+}
+
+}  // namespace
+
+TEST(Utils, TaskChainsResults) {
+  std::string out;
+  auto task = Store(out);
+  // Tasks start only when awaited or spawned.
+  ASSERT_TRUE(out.empty());
+  Spawn(std::move(task));
+  ASSERT_EQ("dfis3", out);
+}